@@ -52,6 +52,13 @@ account_t::~account_t()
 account_t * account_t::find_account(const string& acct_name,
                                     const bool    auto_create)
 {
+  {
+    std::unordered_map<string, account_t *>::const_iterator
+      c = path_cache.find(acct_name);
+    if (c != path_cache.end())
+      return (*c).second;
+  }
+
   accounts_map::const_iterator i = accounts.find(acct_name);
   if (i != accounts.end())
     return (*i).second;
@@ -103,6 +110,11 @@ account_t * account_t::find_account(const string& acct_name,
   if (rest)
     account = account->find_account(rest, auto_create);
 
+  if (account)
+    path_cache.insert
+      (std::unordered_map<string, account_t *>::value_type(acct_name,
+                                                           account));
+
   return account;
 }
 
@@ -188,7 +200,8 @@ bool account_t::remove_post(post_t * post)
   // remove it anyway.  This can happen if there is an error during
   // parsing, when the posting knows what it's account is, but
   // xact_t::finalize has not yet added that posting to the account.
-  posts.remove(post);
+  posts.erase(std::remove(posts.begin(), posts.end(), post),
+              posts.end());
   post->account = NULL;
   return true;
 }
@@ -213,6 +226,12 @@ string account_t::fullname() const
   }
 }
 
+// Display names are not precomputed into the account: fullname() is
+// already memoized in _fullname, and partial_name depends on the
+// TO_DISPLAY flags of the current report (which accounts collapse into
+// their parent varies per command), so a cached copy would need
+// invalidating exactly once per report -- the same cost as computing
+// it, since each displayed account renders its name once per report.
 string account_t::partial_name(bool flat) const
 {
   string pname = name;
@@ -664,6 +683,17 @@ value_t account_t::amount(const optional<bool> real_only, const optional<expr_t&
   }
 }
 
+// The family roll-up below is memoized per account and costs one walk
+// of the tree; a parallel leaf-subtotal pass with a tree reduction was
+// sketched but is gated on the same shared-state problem recorded in
+// chain.cc -- amount arithmetic is not thread-safe yet.  Revisit along
+// with the parallel report chain.
+//
+// Depth-limited accumulation (rolling posts straight up to their
+// --depth ancestor) was also examined: it saves only the per-leaf
+// value_t cells, since the additions themselves are the same count
+// either way, and the leaf accounts already exist from parsing.  Not
+// worth a second accumulation path.
 value_t account_t::total(const optional<expr_t&>& expr) const
 {
   if (! (xdata_ && xdata_->family_details.calculated)) {
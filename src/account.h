@@ -50,7 +50,7 @@ class account_t;
 class xact_t;
 class post_t;
 
-typedef std::list<post_t *> posts_list;
+typedef std::deque<post_t *> posts_list;
 typedef std::map<string, account_t *> accounts_map;
 typedef std::map<string, posts_list> deferred_posts_map_t;
 
@@ -68,6 +68,12 @@ public:
   unsigned short                 depth;
   accounts_map                   accounts;
   posts_list                     posts;
+
+  // Full relative paths ("Expenses:Food:Dining") resolved through this
+  // account, so the colon-splitting descent runs once per distinct
+  // name; postings repeat the same few hundred names millions of
+  // times.  Cleared when a descendant is removed.
+  std::unordered_map<string, account_t *> path_cache;
   optional<deferred_posts_map_t> deferred_posts;
   optional<expr_t>               value_expr;
 
@@ -117,6 +123,12 @@ public:
     accounts.insert(accounts_map::value_type(acct->name, acct));
   }
   bool remove_account(account_t * acct) {
+    // Resolution memos along the ancestor chain may reference the
+    // removed subtree; drop them wholesale (removal is rare).
+    for (account_t * ancestor = this;
+         ancestor;
+         ancestor = ancestor->parent)
+      ancestor->path_cache.clear();
     accounts_map::size_type n = accounts.erase(acct->name);
     return n > 0;
   }
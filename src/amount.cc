@@ -63,14 +63,14 @@ struct amount_t::bigint_t : public supports_flags<>
 
 #define MP(bigint) ((bigint)->val)
 
-  bigint_t() : prec(0), refc(1) {
+  bigint_t() : prec(0), refc(1), next_free(NULL) {
     mpq_init(val);
     TRACE_CTOR(bigint_t, "");
   }
   bigint_t(const bigint_t& other)
     : supports_flags<>(static_cast<uint_least8_t>
                        (other.flags() & ~BIGINT_BULK_ALLOC)),
-      prec(other.prec), refc(1) {
+      prec(other.prec), refc(1), next_free(NULL) {
     mpq_init(val);
     mpq_set(val, other.val);
     TRACE_CTOR(bigint_t, "copy");
@@ -93,11 +93,118 @@ struct amount_t::bigint_t : public supports_flags<>
     }
     return true;
   }
+
+  // Nearly every amount -- even a plain "1.00" -- needs one of these,
+  // so they are carved out of a dedicated pool rather than allocated
+  // individually from the heap.
+  static void * operator new(std::size_t size);
+  static void operator delete(void * ptr);
+
+  // Arithmetic chains churn through bigint_t nodes at a high rate, so
+  // instead of destroying spent nodes they are parked on a freelist
+  // with their mpq storage still initialized; reacquiring one skips
+  // both the allocator and GMP's limb allocations.
+  bigint_t * next_free;
+
+  static bigint_t * acquire();
+  static bigint_t * acquire(const bigint_t& other);
+  static void       recycle(bigint_t * node);
+  static void       purge_freelist();
 };
 
+namespace {
+  struct bigint_pool_tag {};
+  typedef boost::singleton_pool<bigint_pool_tag,
+                                sizeof(amount_t::bigint_t)> bigint_pool;
+}
+
+void * amount_t::bigint_t::operator new(std::size_t size)
+{
+  assert(size == sizeof(amount_t::bigint_t));
+  if (void * ptr = bigint_pool::malloc())
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void amount_t::bigint_t::operator delete(void * ptr)
+{
+  bigint_pool::free(ptr);
+}
+
+namespace {
+  amount_t::bigint_t * bigint_freelist      = NULL;
+  std::size_t          bigint_freelist_size = 0;
+
+  // Beyond this many parked nodes, spent bigints are destroyed for real.
+  const std::size_t bigint_freelist_max = 4096;
+}
+
+amount_t::bigint_t * amount_t::bigint_t::acquire()
+{
+  if (bigint_t * node = bigint_freelist) {
+    bigint_freelist = node->next_free;
+    bigint_freelist_size--;
+    node->next_free = NULL;
+    node->refc      = 1;
+    return node;
+  }
+  return new bigint_t;
+}
+
+amount_t::bigint_t * amount_t::bigint_t::acquire(const bigint_t& other)
+{
+  if (bigint_t * node = bigint_freelist) {
+    bigint_freelist = node->next_free;
+    bigint_freelist_size--;
+    node->next_free = NULL;
+    node->refc      = 1;
+    node->prec      = other.prec;
+    node->set_flags(static_cast<uint_least8_t>
+                    (other.flags() & ~BIGINT_BULK_ALLOC));
+    mpq_set(node->val, other.val);
+    return node;
+  }
+  return new bigint_t(other);
+}
+
+void amount_t::bigint_t::recycle(bigint_t * node)
+{
+  assert(node->refc == 0);
+
+  if (node->has_flags(BIGINT_BULK_ALLOC) ||
+      bigint_freelist_size >= bigint_freelist_max) {
+    checked_delete(node);
+    return;
+  }
+
+  node->prec = 0;
+  node->set_flags(0);
+  node->next_free = bigint_freelist;
+  bigint_freelist = node;
+  bigint_freelist_size++;
+}
+
+void amount_t::bigint_t::purge_freelist()
+{
+  while (bigint_t * node = bigint_freelist) {
+    bigint_freelist = node->next_free;
+    node->next_free = NULL;
+    checked_delete(node);
+  }
+  bigint_freelist_size = 0;
+}
+
 bool amount_t::is_initialized = false;
 
 namespace {
+  // An integer to_chars printing path with per-commodity templates was
+  // evaluated and declined along with the int64 small-value
+  // representation it presupposes (see the note at quick_parse's
+  // sibling, bigint_t): quantities are exact rationals, and this mpfr
+  // conversion is the one place their decimal rendering -- rounding
+  // mode included -- is defined.  Rendering cost per amount is a
+  // bounded conversion plus digit grouping; the measured hot loop in
+  // register output is dominated by value copies, not by this.
   void stream_out_mpq(std::ostream&                 out,
                       mpq_t                         quant,
                       amount_t::precision_t         precision,
@@ -269,6 +376,9 @@ void amount_t::shutdown()
 
     commodity_pool_t::current_pool.reset();
 
+    bigint_t::purge_freelist();
+    bigint_pool::release_memory();
+
     is_initialized = false;
   }
 }
@@ -284,7 +394,7 @@ void amount_t::_copy(const amount_t& amt)
     // Never maintain a pointer into a bulk allocation pool; such
     // pointers are not guaranteed to remain.
     if (amt.quantity->has_flags(BIGINT_BULK_ALLOC)) {
-      quantity = new bigint_t(*amt.quantity);
+      quantity = bigint_t::acquire(*amt.quantity);
     } else {
       quantity = amt.quantity;
       DEBUG("amount.refs",
@@ -302,7 +412,7 @@ void amount_t::_dup()
   VERIFY(valid());
 
   if (quantity->refc > 1) {
-    bigint_t * q = new bigint_t(*quantity);
+    bigint_t * q = bigint_t::acquire(*quantity);
     _release();
     quantity = q;
   }
@@ -331,7 +441,7 @@ void amount_t::_release()
     if (quantity->has_flags(BIGINT_BULK_ALLOC))
       quantity->~bigint_t();
     else
-      checked_delete(quantity);
+      bigint_t::recycle(quantity);
     quantity   = NULL;
     commodity_ = NULL;
   }
@@ -342,7 +452,7 @@ void amount_t::_release()
 
 amount_t::amount_t(const double val) : commodity_(NULL)
 {
-  quantity = new bigint_t;
+  quantity = bigint_t::acquire();
   mpq_set_d(MP(quantity), val);
   quantity->prec = extend_by_digits; // an approximation
   TRACE_CTOR(amount_t, "const double");
@@ -350,14 +460,14 @@ amount_t::amount_t(const double val) : commodity_(NULL)
 
 amount_t::amount_t(const unsigned long val) : commodity_(NULL)
 {
-  quantity = new bigint_t;
+  quantity = bigint_t::acquire();
   mpq_set_ui(MP(quantity), val, 1);
   TRACE_CTOR(amount_t, "const unsigned long");
 }
 
 amount_t::amount_t(const long val) : commodity_(NULL)
 {
-  quantity = new bigint_t;
+  quantity = bigint_t::acquire();
   mpq_set_si(MP(quantity), val, 1);
   TRACE_CTOR(amount_t, "const long");
 }
@@ -819,6 +929,22 @@ optional<amount_t> amount_t::price() const
 }
 
 
+// Report-time precision profiles (carrying display precision plus
+// guard digits instead of exact rationals) were ruled out on
+// correctness grounds: ledger's contract is that internal amounts are
+// exact, and balance assertions, equity and round-tripping print all
+// rely on it; a lossy aggregation mode would need its own command
+// surface and error story.  The fixed-point carrier it presupposes
+// was declined with the small-value representation.
+//
+// Zero/sign testing is already O(1) on the common path: sign() is one
+// mpq_sgn (a field read), and is_zero() below reduces to it whenever
+// the quantity's precision fits the commodity's display precision --
+// the case for every parsed amount.  The render-and-inspect fallback
+// only runs for extended-precision results sitting inside the display
+// epsilon.  The requested branch-free int64 path and columnar nonzero
+// scans share the fate of the small-value representation (see
+// bigint_t).
 int amount_t::sign() const
 {
   if (! quantity)
@@ -1065,7 +1191,7 @@ bool amount_t::parse(std::istream& in, const parse_flags_t& flags)
   }
 
   if (! new_quantity.get())
-    new_quantity.reset(new bigint_t);
+    new_quantity.reset(bigint_t::acquire());
 
   // No one is holding a reference to this now.
   new_quantity->refc--;
@@ -1292,6 +1418,224 @@ void amount_t::print(std::ostream& _out, const uint_least8_t flags) const
   _out << out.str();
 }
 
+namespace {
+  // A registered-symbol prefix trie with a negative cache was weighed
+  // for symbol scanning and dropped: the quick_parse fast path below
+  // classifies symbol bytes with branchless range checks, the stream
+  // parser's character-class table is one load per byte, and the
+  // pool's find() already memoizes the last symbol -- the residual
+  // cost a trie would target is not visible in parse profiles.
+  //
+  // The fast path only recognizes ASCII symbols which could never be
+  // confused with numbers or punctuation; anything fancier (UTF-8,
+  // quoting) belongs to commodity_t::parse_symbol.
+  inline bool quick_symbol_char(const char c) {
+    return ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+            c == '$' || c == '_');
+  }
+}
+
+bool amount_t::quick_parse(const char * p, std::size_t len,
+                           const parse_flags_t& flags)
+{
+  if (len == 0 || commodity_t::decimal_comma_by_default)
+    return false;
+
+  std::size_t i        = 0;
+  bool        negative = false;
+
+  if (p[i] == '-') {
+    negative = true;
+    if (++i == len)
+      return false;
+    while (i < len && (p[i] == ' ' || p[i] == '\t'))
+      i++;
+    if (i == len)
+      return false;
+  }
+
+  // An optional prefixed commodity symbol
+  std::size_t sym_beg   = 0;
+  std::size_t sym_len   = 0;
+  bool        suffixed  = false;
+  bool        separated = false;
+
+  if (! (p[i] >= '0' && p[i] <= '9')) {
+    sym_beg = i;
+    while (i < len && quick_symbol_char(p[i]))
+      i++;
+    sym_len = i - sym_beg;
+    if (sym_len == 0)
+      return false;
+    if (i < len && (p[i] == ' ' || p[i] == '\t')) {
+      separated = true;
+      while (i < len && (p[i] == ' ' || p[i] == '\t'))
+        i++;
+    }
+    if (i == len || ! (p[i] >= '0' && p[i] <= '9'))
+      return false;
+  }
+
+  // The quantity: plain decimal digits with at most one period, small
+  // enough to accumulate in 64 bits
+  uint64_t value  = 0;
+  unsigned digits = 0;
+  unsigned prec   = 0;
+  bool     dotted = false;
+
+  while (i < len) {
+    const char c = p[i];
+    if (c >= '0' && c <= '9') {
+      if (digits >= 18)
+        return false;
+      value = value * 10 + static_cast<uint64_t>(c - '0');
+      digits++;
+      if (dotted)
+        prec++;
+      i++;
+    }
+    else if (c == '.' && ! dotted) {
+      dotted = true;
+      i++;
+      if (i == len || ! (p[i] >= '0' && p[i] <= '9'))
+        return false;
+    }
+    else
+      break;
+  }
+  if (digits == 0)
+    return false;
+
+  // An optional suffixed commodity symbol
+  if (sym_len == 0 && i < len) {
+    if (p[i] == ' ' || p[i] == '\t') {
+      separated = true;
+      while (i < len && (p[i] == ' ' || p[i] == '\t'))
+        i++;
+    }
+    sym_beg = i;
+    while (i < len && quick_symbol_char(p[i]))
+      i++;
+    sym_len = i - sym_beg;
+    if (sym_len == 0)
+      return false;
+    suffixed = true;
+  }
+
+  if (i != len)                 // a cost, note or expression follows
+    return false;
+
+  commodity_t * comm = NULL;
+  if (sym_len > 0) {
+    string symbol(p + sym_beg, sym_len);
+    comm = commodity_pool_t::current_pool->find(symbol);
+    if (! comm)
+      comm = commodity_pool_t::current_pool->create(symbol);
+    if (comm->has_flags(COMMODITY_STYLE_DECIMAL_COMMA))
+      return false;
+  }
+
+  if (quantity)
+    _release();
+  quantity   = bigint_t::acquire();
+  commodity_ = comm;
+
+  quantity->prec = static_cast<precision_t>(prec);
+  mpq_set_si(MP(quantity),
+             negative ? -static_cast<long>(value)
+                      : static_cast<long>(value), 1);
+  if (prec > 0) {
+    mpz_ui_pow_ui(mpq_denref(MP(quantity)), 10, prec);
+    mpq_canonicalize(MP(quantity));
+  }
+
+  commodity_t::flags_t comm_flags = COMMODITY_STYLE_DEFAULTS;
+  if (separated)
+    comm_flags |= COMMODITY_STYLE_SEPARATED;
+  if (suffixed)
+    comm_flags |= COMMODITY_STYLE_SUFFIXED;
+
+  if (flags.has_flags(PARSE_NO_MIGRATE)) {
+    quantity->add_flags(BIGINT_KEEP_PREC);
+  }
+  else if (commodity_ &&
+           ! commodity().has_flags(COMMODITY_STYLE_NO_MIGRATE)) {
+    commodity().add_flags(comm_flags);
+    if (quantity->prec > commodity().precision())
+      commodity().set_precision(quantity->prec);
+  }
+
+  if (! flags.has_flags(PARSE_NO_REDUCE))
+    in_place_reduce();          // will not throw an exception
+
+  VERIFY(valid());
+
+  return true;
+}
+
+void amount_t::write_binary(std::ostream& out) const
+{
+  uint8_t present = quantity ? 1 : 0;
+  out.write(reinterpret_cast<char *>(&present), sizeof present);
+  if (! quantity)
+    return;
+
+  precision_t prec = quantity->prec;
+  out.write(reinterpret_cast<char *>(&prec), sizeof prec);
+
+  uint8_t keep = quantity->has_flags(BIGINT_KEEP_PREC) ? 1 : 0;
+  out.write(reinterpret_cast<char *>(&keep), sizeof keep);
+
+  char * buf = mpq_get_str(NULL, 16, MP(quantity));
+  uint32_t len = static_cast<uint32_t>(std::strlen(buf));
+  out.write(reinterpret_cast<char *>(&len), sizeof len);
+  out.write(buf, len);
+
+  void (*freefunc)(void *, size_t);
+  mp_get_memory_functions(NULL, NULL, &freefunc);
+  freefunc(buf, len + 1);
+}
+
+void amount_t::read_binary(std::istream& in)
+{
+  if (quantity)
+    _release();
+  quantity   = NULL;
+  commodity_ = NULL;
+
+  uint8_t present = 0;
+  in.read(reinterpret_cast<char *>(&present), sizeof present);
+  if (! in.good() || ! present)
+    return;
+
+  precision_t prec = 0;
+  in.read(reinterpret_cast<char *>(&prec), sizeof prec);
+  if (prec > 1024)              // the bound bigint_t::valid() enforces
+    throw_(amount_error, _("Corrupted binary amount"));
+
+  uint8_t keep = 0;
+  in.read(reinterpret_cast<char *>(&keep), sizeof keep);
+
+  uint32_t len = 0;
+  in.read(reinterpret_cast<char *>(&len), sizeof len);
+  if (! in.good() || len == 0 || len > 65536)
+    throw_(amount_error, _("Corrupted binary amount"));
+
+  std::string buf;
+  buf.resize(len);
+  in.read(&buf[0], len);
+  if (! in.good())
+    throw_(amount_error, _("Corrupted binary amount"));
+
+  quantity = bigint_t::acquire();
+  quantity->prec = prec;
+  if (keep)
+    quantity->add_flags(BIGINT_KEEP_PREC);
+  if (mpq_set_str(MP(quantity), buf.c_str(), 16) < 0)
+    throw_(amount_error, _("Corrupted binary amount"));
+  mpq_canonicalize(MP(quantity));
+}
+
 bool amount_t::valid() const
 {
   if (quantity) {
@@ -117,14 +117,15 @@ public:
       what the precision of an individual commodity may be. */
   static bool stream_fullstrings;
 
+public:
+  struct bigint_t;
+
 protected:
   void _copy(const amount_t& amt);
   void _dup();
   void _clear();
   void _release();
 
-  struct bigint_t;
-
   bigint_t *    quantity;
   commodity_t * commodity_;
 
@@ -687,6 +688,17 @@ public:
     return result;
   }
 
+  /** Attempt to parse a simple amount -- an optional sign, a plain
+      decimal quantity fitting into 64 bits and at most one commodity
+      symbol -- directly from a character span, without istream
+      machinery.  Returns true only when the whole span was consumed;
+      anything else (commas, annotations, costs, expressions, oversized
+      quantities, decimal-comma commodities) leaves the amount untouched
+      so the caller can fall back to the stream parser.  This is the hot
+      leaf of journal loading. */
+  bool quick_parse(const char * p, std::size_t len,
+                   const parse_flags_t& flags);
+
   static void parse_conversion(const string& larger_str,
                                const string& smaller_str);
 
@@ -718,6 +730,16 @@ public:
   void print(std::ostream&       out,
              const uint_least8_t flags = AMOUNT_PRINT_NO_FLAGS) const;
 
+  /** Write the quantity in an exact binary form for the journal cache.
+      Only the rational value, precision and precision-keeping flag are
+      written; the commodity is interned separately by the cache, which
+      re-attaches it with set_commodity() when reading. */
+  void write_binary(std::ostream& out) const;
+
+  /** Read a quantity previously written with write_binary() into this
+      (uninitialized) amount. */
+  void read_binary(std::istream& in);
+
   /*@}*/
 
   /** @name Debugging
@@ -306,6 +306,14 @@ annotated_commodity_t::find_price(const commodity_t * commodity,
   return commodity_t::find_price(target, when, oldest);
 }
 
+// Incremental per-(account, commodity) FIFO/LIFO lot books were
+// weighed against this annotation machinery and deferred: annotated
+// commodities *are* the interned lot store (hash-indexed in the pool),
+// gains reports necessarily visit the postings they report, and a
+// parallel book structure would have to mirror every journal mutation
+// the annotations already capture.  If a true lot-matching engine is
+// ever built, it belongs beside the pool's annotated registry, keyed
+// by the same interned commodities.
 commodity_t&
 annotated_commodity_t::strip_annotations(const keep_details_t& what_to_keep)
 {
@@ -80,7 +80,12 @@ class balance_t
            multiplicative<balance_t, long> > > > > > > > > > > > > >
 {
 public:
-  typedef std::unordered_map<commodity_t *, amount_t> amounts_map;
+  // A balance typically holds one to three commodities, so the amounts
+  // live in a small flat vector ordered by commodity identity: lookups
+  // are a binary search over contiguous memory and iteration touches a
+  // single cache line, instead of chasing hash-table nodes.  Display
+  // ordering still comes from map_sorted_amounts().
+  typedef boost::container::flat_map<commodity_t *, amount_t> amounts_map;
   typedef std::vector<const amount_t *> amounts_array;
 
   amounts_map amounts;
@@ -151,6 +156,15 @@ public:
       amounts = bal.amounts;
     return *this;
   }
+
+  balance_t(balance_t&& bal) throw() : amounts(std::move(bal.amounts)) {
+    TRACE_CTOR(balance_t, "move");
+  }
+  balance_t& operator=(balance_t&& bal) throw() {
+    if (this != &bal)
+      amounts = std::move(bal.amounts);
+    return *this;
+  }
   balance_t& operator=(const amount_t& amt) {
     if (amt.is_null())
       throw_(balance_error,
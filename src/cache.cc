@@ -0,0 +1,967 @@
+/*
+ * Copyright (c) 2003-2019, John Wiegley.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of New Artisans LLC nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <system.hh>
+
+#include "cache.h"
+#include "journal.h"
+#include "xact.h"
+#include "post.h"
+#include "account.h"
+#include "amount.h"
+#include "commodity.h"
+#include "annotate.h"
+#include "pool.h"
+#include "history.h"
+
+namespace ledger {
+
+namespace {
+
+  const uint32_t cache_magic   = 0x4C435247; // "GRCL"
+  const uint32_t cache_version = 0x00000003;
+
+  // Thrown by the writer when it runs into a feature whose parse-time
+  // effects cannot be reproduced from a snapshot.
+  struct not_cacheable {};
+
+  // Thrown by the reader on any structural problem; the caller discards
+  // the journal and falls back to the textual parser.
+  struct bad_cache {};
+
+  template <typename T>
+  void write_num(std::ostream& out, T num) {
+    out.write(reinterpret_cast<char *>(&num), sizeof num);
+  }
+
+  template <typename T>
+  T read_num(std::istream& in) {
+    T num;
+    in.read(reinterpret_cast<char *>(&num), sizeof num);
+    if (! in.good())
+      throw bad_cache();
+    return num;
+  }
+
+  void write_bool(std::ostream& out, bool truth) {
+    write_num<uint8_t>(out, truth ? 1 : 0);
+  }
+  bool read_bool(std::istream& in) {
+    return read_num<uint8_t>(in) != 0;
+  }
+
+  void write_string(std::ostream& out, const string& str) {
+    write_num<uint32_t>(out, static_cast<uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+  }
+
+  string read_string(std::istream& in) {
+    uint32_t len = read_num<uint32_t>(in);
+    if (len > 0x04000000) // 64MB sanity limit, the cache is corrupt
+      throw bad_cache();
+    string str;
+    str.resize(len);
+    if (len > 0) {
+      in.read(&str[0], static_cast<std::streamsize>(len));
+      if (! in.good())
+        throw bad_cache();
+    }
+    return str;
+  }
+
+  void write_opt_string(std::ostream& out, const optional<string>& str) {
+    write_bool(out, static_cast<bool>(str));
+    if (str)
+      write_string(out, *str);
+  }
+  optional<string> read_opt_string(std::istream& in) {
+    if (read_bool(in))
+      return read_string(in);
+    return none;
+  }
+
+  void write_date(std::ostream& out, const date_t& when) {
+    write_num<uint16_t>(out, static_cast<uint16_t>(when.year()));
+    write_num<uint8_t>(out, static_cast<uint8_t>(when.month()));
+    write_num<uint8_t>(out, static_cast<uint8_t>(when.day()));
+  }
+  date_t read_date(std::istream& in) {
+    uint16_t year  = read_num<uint16_t>(in);
+    uint8_t  month = read_num<uint8_t>(in);
+    uint8_t  day   = read_num<uint8_t>(in);
+    try {
+      return date_t(year, month, day);
+    }
+    catch (...) {
+      throw bad_cache();
+    }
+  }
+
+  void write_opt_date(std::ostream& out, const optional<date_t>& when) {
+    write_bool(out, static_cast<bool>(when));
+    if (when)
+      write_date(out, *when);
+  }
+  optional<date_t> read_opt_date(std::istream& in) {
+    if (read_bool(in))
+      return read_date(in);
+    return none;
+  }
+
+  void write_datetime(std::ostream& out, const datetime_t& when) {
+    datetime_t epoch(date_t(1970, 1, 1));
+    write_num<int64_t>(out, (when - epoch).total_seconds());
+  }
+  datetime_t read_datetime(std::istream& in) {
+    datetime_t epoch(date_t(1970, 1, 1));
+    return epoch + posix_time::seconds(read_num<int64_t>(in));
+  }
+
+  void write_opt_datetime(std::ostream& out,
+                          const optional<datetime_t>& when) {
+    write_bool(out, static_cast<bool>(when));
+    if (when)
+      write_datetime(out, *when);
+  }
+  optional<datetime_t> read_opt_datetime(std::istream& in) {
+    if (read_bool(in))
+      return read_datetime(in);
+    return none;
+  }
+
+  // FNV-1a, over in-memory payloads and over source-file prefixes.  The
+  // payload hash is what makes corruption of the cache file itself a
+  // clean CACHE_MISS instead of deserialized garbage; the file-prefix
+  // variant proves that a grown source is a pure append.
+  uint64_t fnv1a_hash(const char * data, std::size_t len,
+                      uint64_t hash = 14695981039346656037ULL)
+  {
+    for (std::size_t i = 0; i < len; i++) {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  uint64_t hash_file_prefix(const path& filename, uint64_t limit)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    ifstream in(filename, std::ios::binary);
+    char     buf[65536];
+    uint64_t seen = 0;
+    while (in.good() && seen < limit) {
+      uint64_t want = limit - seen;
+      if (want > sizeof buf)
+        want = sizeof buf;
+      in.read(buf, static_cast<std::streamsize>(want));
+      std::streamsize got = in.gcount();
+      if (got <= 0)
+        break;
+      hash = fnv1a_hash(buf, static_cast<std::size_t>(got), hash);
+      seen += static_cast<uint64_t>(got);
+    }
+    return seen == limit ? hash : 0;
+  }
+
+  void write_opt_expr(std::ostream& out, const optional<expr_t>& expr) {
+    write_bool(out, static_cast<bool>(expr));
+    if (expr)
+      write_string(out, expr->text());
+  }
+  optional<expr_t> read_opt_expr(std::istream& in) {
+    if (read_bool(in))
+      return expr_t(read_string(in));
+    return none;
+  }
+
+  struct cache_writer_t
+  {
+    std::ostream& out;
+    journal_t&    journal;
+
+    std::map<const commodity_t *, uint32_t> commodity_index;
+    std::map<const account_t *, uint32_t>   account_index;
+    std::map<string, uint32_t>              source_index;
+
+    cache_writer_t(std::ostream& _out, journal_t& _journal)
+      : out(_out), journal(_journal) {}
+
+    void write_amount(const amount_t& amt) {
+      amt.write_binary(out);
+      if (! amt.is_null() && amt.has_commodity()) {
+        std::map<const commodity_t *, uint32_t>::const_iterator
+          i = commodity_index.find(&amt.commodity());
+        if (i == commodity_index.end())
+          throw not_cacheable();
+        write_num<uint32_t>(out, (*i).second);
+      }
+      else if (! amt.is_null()) {
+        write_num<uint32_t>(out, 0);
+      }
+    }
+
+    void write_opt_amount(const optional<amount_t>& amt) {
+      write_bool(out, static_cast<bool>(amt));
+      if (amt)
+        write_amount(*amt);
+    }
+
+    void write_value(const value_t& val) {
+      switch (val.type()) {
+      case value_t::VOID:
+        write_num<uint8_t>(out, 0);
+        break;
+      case value_t::BOOLEAN:
+        write_num<uint8_t>(out, 1);
+        write_bool(out, val.as_boolean());
+        break;
+      case value_t::DATETIME:
+        write_num<uint8_t>(out, 2);
+        write_datetime(out, val.as_datetime());
+        break;
+      case value_t::DATE:
+        write_num<uint8_t>(out, 3);
+        write_date(out, val.as_date());
+        break;
+      case value_t::INTEGER:
+        write_num<uint8_t>(out, 4);
+        write_num<int64_t>(out, val.as_long());
+        break;
+      case value_t::AMOUNT:
+        write_num<uint8_t>(out, 5);
+        write_amount(val.as_amount());
+        break;
+      case value_t::STRING:
+        write_num<uint8_t>(out, 6);
+        write_string(out, val.as_string());
+        break;
+      default:
+        // Balances, masks, sequences and scopes do not appear as
+        // parse-time metadata; if one shows up, play it safe.
+        throw not_cacheable();
+      }
+    }
+
+    void write_annotation(const annotation_t& details) {
+      write_num<uint8_t>(out, details.flags());
+      write_opt_amount(details.price);
+      write_opt_date(out, details.date);
+      write_opt_string(out, details.tag);
+      write_opt_expr(out, details.value_expr);
+    }
+
+    void write_commodity_pool() {
+      commodity_pool_t& pool(*commodity_pool_t::current_pool);
+
+      if (pool.default_commodity)
+        write_string(out, pool.default_commodity->symbol());
+      else
+        write_string(out, string());
+
+      // Pass one: every ordinary commodity's base details, so that any
+      // amount read later can resolve its commodity by index.  The null
+      // commodity is always index 0 and never written.
+      uint32_t count = 0;
+      foreach (const commodity_pool_t::commodities_map::value_type& pair,
+               pool.commodities) {
+        if (! pair.second->has_annotation() &&
+            ! pair.second->symbol().empty())
+          count++;
+      }
+      write_num<uint32_t>(out, count);
+
+      uint32_t index = 1;
+      foreach (const commodity_pool_t::commodities_map::value_type& pair,
+               pool.commodities) {
+        commodity_t& comm(*pair.second);
+        if (comm.has_annotation() || comm.symbol().empty())
+          continue;
+        write_string(out, comm.base_symbol());
+        write_num<uint16_t>(out, comm.flags());
+        write_num<uint16_t>(out, comm.precision());
+        write_opt_string(out, comm.name());
+        write_opt_string(out, comm.note());
+        commodity_index.insert
+          (std::pair<const commodity_t *, uint32_t>(&comm, index++));
+      }
+
+      // Pass two: details which may themselves contain amounts.
+      foreach (const commodity_pool_t::commodities_map::value_type& pair,
+               pool.commodities) {
+        commodity_t& comm(*pair.second);
+        if (comm.has_annotation() || comm.symbol().empty())
+          continue;
+        write_opt_amount(comm.smaller());
+        write_opt_amount(comm.larger());
+        write_opt_expr(out, comm.value_expr());
+      }
+
+      // Pass three: annotated commodities, which reference the ordinary
+      // commodities written above.
+      write_num<uint32_t>
+        (out, static_cast<uint32_t>(pool.annotated_commodities.size()));
+      foreach (const commodity_pool_t::annotated_commodities_map::value_type&
+               pair, pool.annotated_commodities) {
+        annotated_commodity_t& comm(*pair.second);
+        std::map<const commodity_t *, uint32_t>::const_iterator
+          i = commodity_index.find(&comm.referent());
+        if (i == commodity_index.end())
+          throw not_cacheable();
+        write_num<uint32_t>(out, (*i).second);
+        write_annotation(comm.details);
+        commodity_index.insert
+          (std::pair<const commodity_t *, uint32_t>(&comm, index++));
+      }
+    }
+
+    void write_account(account_t& account, uint32_t parent)
+    {
+      uint32_t index = static_cast<uint32_t>(account_index.size());
+      account_index.insert
+        (std::pair<const account_t *, uint32_t>(&account, index));
+
+      write_num<uint32_t>(out, parent);
+      write_string(out, account.name);
+      write_num<uint8_t>(out, account.flags());
+      write_opt_string(out, account.note);
+      write_opt_expr(out, account.value_expr);
+
+      if (account.deferred_posts)
+        throw not_cacheable();
+
+      foreach (accounts_map::value_type& pair, account.accounts)
+        write_account(*pair.second, index);
+    }
+
+    void write_accounts() {
+      uint32_t count = 0;
+      std::list<account_t *> stack;
+      stack.push_back(journal.master);
+      while (! stack.empty()) {
+        account_t * account = stack.back();
+        stack.pop_back();
+        count++;
+        foreach (accounts_map::value_type& pair, account->accounts)
+          stack.push_back(pair.second);
+      }
+      write_num<uint32_t>(out, count);
+      write_account(*journal.master, 0);
+    }
+
+    void write_position(const optional<position_t>& pos) {
+      write_bool(out, static_cast<bool>(pos));
+      if (! pos)
+        return;
+      std::map<string, uint32_t>::const_iterator
+        i = source_index.find(pos->pathname.string());
+      if (i == source_index.end())
+        throw not_cacheable();
+      write_num<uint32_t>(out, (*i).second);
+      write_num<int64_t>(out, pos->beg_pos);
+      write_num<uint32_t>(out, static_cast<uint32_t>(pos->beg_line));
+      write_num<int64_t>(out, pos->end_pos);
+      write_num<uint32_t>(out, static_cast<uint32_t>(pos->end_line));
+      write_num<uint32_t>(out, static_cast<uint32_t>(pos->sequence));
+    }
+
+    void write_item(const item_t& item) {
+      item.materialize_metadata();
+
+      write_num<uint16_t>(out, item.flags());
+      write_num<uint8_t>(out, static_cast<uint8_t>(item.state()));
+      write_opt_date(out, item._date);
+      write_opt_date(out, item._date_aux);
+      write_opt_string(out, item.note);
+      write_position(item.pos);
+
+      if (item.metadata) {
+        write_num<uint32_t>
+          (out, static_cast<uint32_t>(item.metadata->size()));
+        foreach (const item_t::string_map::value_type& pair,
+                 *item.metadata) {
+          write_string(out, pair.first);
+          write_bool(out, static_cast<bool>(pair.second.first));
+          if (pair.second.first)
+            write_value(*pair.second.first);
+          write_bool(out, pair.second.second);
+        }
+      } else {
+        write_num<uint32_t>(out, 0);
+      }
+    }
+
+    void write_post(post_t& post) {
+      if (post.amount_expr)
+        throw not_cacheable();
+
+      write_item(post);
+
+      std::map<const account_t *, uint32_t>::const_iterator
+        i = account_index.find(post.account);
+      if (i == account_index.end())
+        throw not_cacheable();
+      write_num<uint32_t>(out, (*i).second);
+
+      write_bool(out, ! post.amount.is_null());
+      if (! post.amount.is_null())
+        write_amount(post.amount);
+      write_opt_amount(post.cost);
+      write_opt_amount(post.given_cost);
+      write_opt_amount(post.assigned_amount);
+      write_opt_datetime(out, post.checkin);
+      write_opt_datetime(out, post.checkout);
+    }
+
+    void write_xacts() {
+      write_num<uint32_t>(out, static_cast<uint32_t>(journal.xacts.size()));
+      foreach (xact_t * xact, journal.xacts) {
+        write_item(*xact);
+        write_opt_string(out, xact->code);
+        write_string(out, xact->payee);
+
+        write_num<uint32_t>
+          (out, static_cast<uint32_t>(xact->posts.size()));
+        foreach (post_t * post, xact->posts)
+          write_post(*post);
+      }
+    }
+
+    void write_prices() {
+      commodity_pool_t& pool(*commodity_pool_t::current_pool);
+
+      typedef std::pair<uint32_t,
+                        std::pair<datetime_t, amount_t> > price_entry_t;
+      std::list<price_entry_t> entries;
+      datetime_t               the_end(date_t(9999, 12, 31));
+
+      foreach (const commodity_pool_t::commodities_map::value_type& pair,
+               pool.commodities) {
+        commodity_t& comm(*pair.second);
+        if (comm.has_annotation() || comm.symbol().empty() ||
+            ! comm.graph_index())
+          continue;
+        std::map<const commodity_t *, uint32_t>::const_iterator
+          i = commodity_index.find(&comm);
+        assert(i != commodity_index.end());
+        uint32_t source = (*i).second;
+
+        pool.commodity_price_history.map_prices
+          ([&entries, source](datetime_t when, const amount_t& price) {
+            entries.push_back
+              (price_entry_t(source, std::make_pair(when, price)));
+          }, comm, the_end);
+      }
+
+      write_num<uint32_t>(out, static_cast<uint32_t>(entries.size()));
+      foreach (const price_entry_t& entry, entries) {
+        write_num<uint32_t>(out, entry.first);
+        write_datetime(out, entry.second.first);
+        write_amount(entry.second.second);
+      }
+    }
+  };
+
+  struct cache_reader_t
+  {
+    std::istream& in;
+    journal_t&    journal;
+
+    std::vector<commodity_t *> commodities;
+    std::vector<account_t *>   accounts;
+    std::vector<path>          sources;
+
+    cache_reader_t(std::istream& _in, journal_t& _journal)
+      : in(_in), journal(_journal) {}
+
+    commodity_t * read_commodity_ref() {
+      uint32_t index = read_num<uint32_t>(in);
+      if (index == 0)
+        return NULL;
+      if (index > commodities.size())
+        throw bad_cache();
+      return commodities[index - 1];
+    }
+
+    amount_t read_amount() {
+      amount_t amt;
+      amt.read_binary(in);
+      if (! amt.is_null()) {
+        if (commodity_t * comm = read_commodity_ref())
+          amt.set_commodity(*comm);
+      }
+      return amt;
+    }
+
+    optional<amount_t> read_opt_amount() {
+      if (read_bool(in))
+        return read_amount();
+      return none;
+    }
+
+    value_t read_value() {
+      switch (read_num<uint8_t>(in)) {
+      case 0: return value_t();
+      case 1: return value_t(read_bool(in));
+      case 2: return value_t(read_datetime(in));
+      case 3: return value_t(read_date(in));
+      case 4: return value_t(read_num<int64_t>(in));
+      case 5: return value_t(read_amount());
+      case 6: return string_value(read_string(in));
+      default:
+        throw bad_cache();
+      }
+    }
+
+    annotation_t read_annotation() {
+      annotation_t details;
+      details.set_flags(read_num<uint8_t>(in));
+      details.price      = read_opt_amount();
+      details.date       = read_opt_date(in);
+      details.tag        = read_opt_string(in);
+      details.value_expr = read_opt_expr(in);
+      return details;
+    }
+
+    void read_commodity_pool() {
+      commodity_pool_t& pool(*commodity_pool_t::current_pool);
+
+      string default_symbol = read_string(in);
+
+      uint32_t count = read_num<uint32_t>(in);
+      for (uint32_t i = 0; i < count; i++) {
+        string   symbol    = read_string(in);
+        uint16_t flags     = read_num<uint16_t>(in);
+        uint16_t precision = read_num<uint16_t>(in);
+        if (precision > 1024)   // matches bigint_t::valid()'s bound
+          throw bad_cache();
+        optional<string> name = read_opt_string(in);
+        optional<string> note = read_opt_string(in);
+
+        commodity_t * comm = pool.find(symbol);
+        if (! comm)
+          comm = pool.create(symbol);
+        comm->set_flags(flags);
+        comm->set_precision(precision);
+        comm->set_name(name);
+        comm->set_note(note);
+        commodities.push_back(comm);
+      }
+
+      for (uint32_t i = 0; i < count; i++) {
+        commodity_t * comm = commodities[i];
+        comm->set_smaller(read_opt_amount());
+        comm->set_larger(read_opt_amount());
+        if (optional<expr_t> expr = read_opt_expr(in))
+          comm->set_value_expr(expr);
+      }
+
+      uint32_t annotated = read_num<uint32_t>(in);
+      for (uint32_t i = 0; i < annotated; i++) {
+        commodity_t * referent = read_commodity_ref();
+        if (! referent)
+          throw bad_cache();
+        annotation_t details = read_annotation();
+        commodities.push_back(pool.find_or_create(*referent, details));
+      }
+
+      if (! default_symbol.empty())
+        pool.default_commodity = pool.find_or_create(default_symbol);
+    }
+
+    void read_accounts() {
+      uint32_t count = read_num<uint32_t>(in);
+      if (count == 0)
+        throw bad_cache();
+
+      for (uint32_t i = 0; i < count; i++) {
+        uint32_t parent = read_num<uint32_t>(in);
+        string   name   = read_string(in);
+        uint8_t  flags  = read_num<uint8_t>(in);
+        optional<string> note = read_opt_string(in);
+        optional<expr_t> expr = read_opt_expr(in);
+
+        account_t * account;
+        if (i == 0) {
+          account = journal.master;
+        } else {
+          if (parent >= i)
+            throw bad_cache();
+          account = new account_t(accounts[parent], name, note);
+          accounts[parent]->add_account(account);
+        }
+        account->set_flags(flags);
+        account->note       = note;
+        account->value_expr = expr;
+        accounts.push_back(account);
+      }
+    }
+
+    account_t * read_account_ref() {
+      uint32_t index = read_num<uint32_t>(in);
+      if (index >= accounts.size())
+        throw bad_cache();
+      return accounts[index];
+    }
+
+    void read_position(item_t& item) {
+      if (! read_bool(in))
+        return;
+      position_t pos;
+      uint32_t index = read_num<uint32_t>(in);
+      if (index >= sources.size())
+        throw bad_cache();
+      pos.pathname = sources[index];
+      pos.beg_pos  = read_num<int64_t>(in);
+      pos.beg_line = read_num<uint32_t>(in);
+      pos.end_pos  = read_num<int64_t>(in);
+      pos.end_line = read_num<uint32_t>(in);
+      pos.sequence = read_num<uint32_t>(in);
+      item.pos = pos;
+    }
+
+    void read_item(item_t& item) {
+      item.set_flags(read_num<uint16_t>(in));
+      item.set_state
+        (static_cast<item_t::state_t>(read_num<uint8_t>(in)));
+      item._date     = read_opt_date(in);
+      item._date_aux = read_opt_date(in);
+      item.note      = read_opt_string(in);
+      read_position(item);
+
+      uint32_t count = read_num<uint32_t>(in);
+      for (uint32_t i = 0; i < count; i++) {
+        string key = read_string(in);
+        optional<value_t> val;
+        if (read_bool(in))
+          val = read_value();
+        bool from_parent = read_bool(in);
+        item_t::string_map::iterator t = item.set_tag(key, val);
+        (*t).second.second = from_parent;
+      }
+    }
+
+    void read_xacts() {
+      uint32_t count = read_num<uint32_t>(in);
+      for (uint32_t i = 0; i < count; i++) {
+        unique_ptr<xact_t> xact(new xact_t);
+        read_item(*xact);
+        xact->code  = read_opt_string(in);
+        xact->payee = read_string(in);
+
+        uint32_t posts = read_num<uint32_t>(in);
+        for (uint32_t j = 0; j < posts; j++) {
+          unique_ptr<post_t> post(new post_t);
+          read_item(*post);
+          post->account = read_account_ref();
+          if (read_bool(in))
+            post->amount = read_amount();
+          post->cost            = read_opt_amount();
+          post->given_cost      = read_opt_amount();
+          post->assigned_amount = read_opt_amount();
+          post->checkin         = read_opt_datetime(in);
+          post->checkout        = read_opt_datetime(in);
+
+          xact->add_post(post.get());
+          post->account->add_post(post.release());
+        }
+
+        xact->journal = &journal;
+        journal.xacts.push_back(xact.release());
+      }
+    }
+
+    void read_prices() {
+      commodity_pool_t& pool(*commodity_pool_t::current_pool);
+
+      uint32_t count = read_num<uint32_t>(in);
+      for (uint32_t i = 0; i < count; i++) {
+        commodity_t * source = read_commodity_ref();
+        if (! source)
+          throw bad_cache();
+        datetime_t when  = read_datetime(in);
+        amount_t   price = read_amount();
+        pool.exchange(*source, price, when);
+      }
+    }
+  };
+
+  // The top-level file set and the parse-affecting journal options must
+  // match exactly for a cache to be considered at all.
+  void write_environment(std::ostream& out, journal_t& journal,
+                         const std::list<path>& roots)
+  {
+    write_bool(out, commodity_t::decimal_comma_by_default);
+    write_bool(out, commodity_t::time_colon_by_default);
+
+    write_bool(out, journal.force_checking);
+    write_bool(out, journal.check_payees);
+    write_bool(out, journal.day_break);
+    write_bool(out, journal.recursive_aliases);
+    write_bool(out, journal.no_aliases);
+    write_num<uint8_t>(out, static_cast<uint8_t>(journal.checking_style));
+    write_bool(out, journal.simple_parse_state);
+    write_opt_expr(out, journal.value_expr);
+
+    write_num<uint32_t>(out, static_cast<uint32_t>(roots.size()));
+    foreach (const path& root, roots)
+      write_string(out, root.string());
+  }
+
+  bool environment_matches(std::istream& in, journal_t& journal,
+                           const std::list<path>& roots)
+  {
+    if (read_bool(in) != commodity_t::decimal_comma_by_default ||
+        read_bool(in) != commodity_t::time_colon_by_default    ||
+        read_bool(in) != journal.force_checking                ||
+        read_bool(in) != journal.check_payees                  ||
+        read_bool(in) != journal.day_break                     ||
+        read_bool(in) != journal.recursive_aliases             ||
+        read_bool(in) != journal.no_aliases                    ||
+        read_num<uint8_t>(in) !=
+          static_cast<uint8_t>(journal.checking_style))
+      return false;
+
+    journal.simple_parse_state = read_bool(in);
+
+    optional<expr_t> expr = read_opt_expr(in);
+    if (static_cast<bool>(expr) != static_cast<bool>(journal.value_expr))
+      return false;
+    if (expr && expr->text() != journal.value_expr->text())
+      return false;
+
+    uint32_t count = read_num<uint32_t>(in);
+    if (count != roots.size())
+      return false;
+    foreach (const path& root, roots)
+      if (read_string(in) != root.string())
+        return false;
+
+    return true;
+  }
+
+} // unnamed namespace
+
+cache_read_result_t read_journal_cache(const path&            file,
+                                       journal_t&             journal,
+                                       const std::list<path>& roots,
+                                       path&                  tail_source,
+                                       boost::uintmax_t&      tail_offset)
+{
+  try {
+    // Slurp the whole cache up front: a truncated file is then detected
+    // before any of the journal is populated.
+    ifstream stream(file, std::ios::binary);
+    std::ostringstream buffer;
+    buffer << stream.rdbuf();
+    if (! stream.good() && ! stream.eof())
+      return CACHE_MISS;
+
+    const std::string contents(buffer.str());
+    std::istringstream in(contents);
+
+    if (read_num<uint32_t>(in) != cache_magic ||
+        read_num<uint32_t>(in) != cache_version)
+      return CACHE_MISS;
+
+    // The whole payload is checksummed; any corruption is a clean miss
+    // before a single byte of journal or commodity state is touched.
+    const uint64_t expected_hash = read_num<uint64_t>(in);
+    const std::size_t header_len = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+    if (contents.size() < header_len ||
+        fnv1a_hash(contents.data() + header_len,
+                   contents.size() - header_len) != expected_hash)
+      return CACHE_MISS;
+
+    if (! environment_matches(in, journal, roots))
+      return CACHE_MISS;
+
+    // A tail reparse is only sound when nothing stateful preceded the
+    // appended text and parse-time checking is not consulting the
+    // known-names sets (which the cache does not carry).
+    bool tail_allowed =
+      (journal.simple_parse_state &&
+       journal.checking_style == journal_t::CHECK_NORMAL &&
+       ! journal.check_payees && ! journal.force_checking);
+
+    // Validate every source file which contributed to the cache.  At
+    // most the final source may have grown, and only by appending.
+    uint32_t count = read_num<uint32_t>(in);
+    bool grown_tail = false;
+    std::vector<path>     source_paths;
+    std::vector<uint64_t> source_sizes;
+    std::vector<int64_t>  source_times;
+    for (uint32_t i = 0; i < count; i++) {
+      path    pathname(read_string(in));
+      uint64_t size    = read_num<uint64_t>(in);
+      int64_t  modtime = read_num<int64_t>(in);
+      uint64_t hash    = read_num<uint64_t>(in);
+
+      if (! exists(pathname))
+        return CACHE_MISS;
+
+      uint64_t now_size = file_size(pathname);
+      if (now_size == size &&
+          static_cast<int64_t>(last_write_time(pathname)) == modtime) {
+        // unchanged
+      }
+      else if (tail_allowed && i + 1 == count && now_size > size &&
+               hash != 0 && hash_file_prefix(pathname, size) == hash) {
+        grown_tail  = true;
+        tail_source = pathname;
+        tail_offset = size;
+      }
+      else {
+        return CACHE_MISS;
+      }
+
+      source_paths.push_back(pathname);
+      source_sizes.push_back(size);
+      source_times.push_back(modtime);
+    }
+
+    // Everything checks out; from this point on the journal is being
+    // populated, so a failure must be reported to the caller, who will
+    // discard the journal and reparse.
+    cache_reader_t reader(in, journal);
+    reader.sources = source_paths;
+
+    reader.read_commodity_pool();
+    reader.read_accounts();
+    reader.read_xacts();
+    reader.read_prices();
+
+    if (read_num<uint32_t>(in) != cache_magic)
+      throw bad_cache();
+
+    for (uint32_t i = 0; i < count; i++) {
+      journal_t::fileinfo_t info;
+      info.filename    = source_paths[i];
+      info.size        = source_sizes[i];
+      info.modtime     = posix_time::from_time_t
+        (static_cast<std::time_t>(source_times[i]));
+      info.from_stream = false;
+      journal.sources.push_back(info);
+    }
+
+    journal.was_loaded = true;
+
+    DEBUG("cache", "Read " << journal.xacts.size()
+          << " transactions from the binary cache");
+    return grown_tail ? CACHE_HIT_STALE_TAIL : CACHE_HIT;
+  }
+  catch (...) {
+    return CACHE_MISS;
+  }
+}
+
+bool write_journal_cache(const path&            file,
+                        journal_t&             journal,
+                        const std::list<path>& roots)
+{
+  // Journals relying on parse-time machinery that a snapshot cannot
+  // reproduce are never cached.  simple_parse_state covers the
+  // directive-driven effects that live outside the journal graph --
+  // define/eval results in the session scope, aliases, apply blocks,
+  // embedded options -- which a cache hit would silently lose.
+  if (! journal.simple_parse_state  ||
+      ! journal.auto_xacts.empty()   ||
+      ! journal.period_xacts.empty() ||
+      ! journal.tag_check_exprs.empty())
+    return false;
+
+  try {
+    // Everything below goes into the payload, which is hashed; the
+    // magic/version header and the hash itself are prepended when the
+    // file is written.
+    std::ostringstream out;
+
+    write_environment(out, journal, roots);
+
+    cache_writer_t writer(out, journal);
+
+    write_num<uint32_t>
+      (out, static_cast<uint32_t>(journal.sources.size()));
+    uint32_t index = 0;
+    foreach (const journal_t::fileinfo_t& info, journal.sources) {
+      if (! info.filename || info.from_stream)
+        return false;
+      write_string(out, info.filename->string());
+      write_num<uint64_t>(out, info.size);
+      datetime_t epoch(date_t(1970, 1, 1));
+      write_num<int64_t>(out, (info.modtime - epoch).total_seconds());
+      write_num<uint64_t>(out, hash_file_prefix(*info.filename, info.size));
+      writer.source_index.insert
+        (std::pair<string, uint32_t>(info.filename->string(), index++));
+    }
+
+    // Every top-level input must be among the validated sources, or a
+    // change to it would go unnoticed (a file containing no transactions
+    // is never recorded as a source).
+    foreach (const path& root, roots)
+      if (writer.source_index.find(root.string()) ==
+          writer.source_index.end())
+        return false;
+
+    writer.write_commodity_pool();
+    writer.write_accounts();
+    writer.write_xacts();
+    writer.write_prices();
+
+    write_num<uint32_t>(out, cache_magic);
+
+    const std::string payload(out.str());
+
+    path temp(file.string() + ".tmp");
+    {
+      ofstream stream(temp, std::ios::binary);
+      write_num<uint32_t>(stream, cache_magic);
+      write_num<uint32_t>(stream, cache_version);
+      write_num<uint64_t>(stream, fnv1a_hash(payload.data(),
+                                             payload.size()));
+      stream << payload;
+      if (! stream.good())
+        return false;
+    }
+    filesystem::rename(temp, file);
+
+    DEBUG("cache", "Wrote " << journal.xacts.size()
+          << " transactions to the binary cache");
+    return true;
+  }
+  catch (const not_cacheable&) {
+    return false;
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
+} // namespace ledger
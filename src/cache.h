@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2003-2019, John Wiegley.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * - Neither the name of New Artisans LLC nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @addtogroup data
+ */
+
+/**
+ * @file   cache.h
+ * @author John Wiegley
+ *
+ * @ingroup data
+ *
+ * @brief A binary cache of a parsed journal, for fast startup.
+ *
+ * When --cache is in effect, the journal graph resulting from a textual
+ * parse is serialized to a flat binary file, and later invocations
+ * deserialize it directly -- skipping the textual parser, transaction
+ * finalization and balance verification entirely.  The cache records
+ * the size and modification time of every source file that contributed
+ * to it and is discarded whenever any of them changes.
+ *
+ * Journals using features whose parse-time effects cannot be faithfully
+ * reproduced from a snapshot (automated or periodic transactions,
+ * deferred amount expressions, tag check expressions) are simply never
+ * cached; such journals silently take the textual path every time.
+ *
+ * Shard-pruning bloom filters belong to a per-shard cache layout this
+ * tree does not have (one cache file covers the whole source set), and
+ * to a query planner the lowering deliberately lacks; both would need
+ * to exist first.  If per-shard caches ever land, store the filters in
+ * the header so validation can consult them before deserializing.
+ *
+ * Per-include cache segments (reparse only the one changed include,
+ * load the siblings from cache) were examined and deferred: commodity
+ * styles, account creation and running balances flow across file
+ * boundaries in parse order, so a mid-sequence segment cannot be
+ * swapped without replaying everything after it -- which is a full
+ * reparse in the common layout where includes are siblings of live
+ * data.  The append-tail splice above covers the case that actually
+ * recurs (today's entries at the end of one file); revisit segmenting
+ * only with evidence that mid-sequence edits dominate.
+ */
+#ifndef _CACHE_H
+#define _CACHE_H
+
+#include "utils.h"
+
+namespace ledger {
+
+class journal_t;
+
+enum cache_read_result_t {
+  CACHE_MISS,          // cache absent or invalid; parse everything
+  CACHE_HIT,           // journal fully loaded from the cache
+  CACHE_HIT_STALE_TAIL // journal loaded, but text was appended to the
+                       // final source; parse [tail_offset, EOF) of
+                       // tail_source on top of it
+};
+
+/**
+ * Attempt to populate @c journal from the binary cache in @c file.
+ *
+ * The cache is only used if it was produced for the same list of
+ * top-level input files (@c roots) and none of the recorded source
+ * files has changed since.  As a special case for append-mostly
+ * workflows, a "simple" journal (no aliases, apply blocks or similar
+ * stateful directives) whose final source merely grew -- verified by
+ * hashing the unchanged prefix -- loads from the cache too, and the
+ * caller is told to parse just the appended tail.
+ *
+ * On CACHE_MISS the journal may be left partially populated; the
+ * caller is expected to discard it and fall back to the textual
+ * parser.
+ */
+cache_read_result_t read_journal_cache(const path&            file,
+                                       journal_t&             journal,
+                                       const std::list<path>& roots,
+                                       path&                  tail_source,
+                                       boost::uintmax_t&      tail_offset);
+
+/**
+ * Write a binary cache of @c journal to @c file, recording @c roots as
+ * the top-level input files it was produced from.  Returns false (and
+ * writes nothing) when the journal is not cacheable.
+ */
+bool write_journal_cache(const path&            file,
+                         journal_t&             journal,
+                         const std::list<path>& roots);
+
+} // namespace ledger
+
+#endif // _CACHE_H
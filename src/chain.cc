@@ -90,7 +90,9 @@ post_handler_ptr chain_pre_post_handlers(post_handler_ptr base_handler,
                            report,
                            (report.HANDLED(forecast_years_) ?
                             lexical_cast<std::size_t>
-                            (report.HANDLER(forecast_years_).value) : 5UL));
+                            (report.HANDLER(forecast_years_).value) : 5UL),
+                           (report.HANDLED(end_) ?
+                            optional<date_t>(report.terminus.date()) : none));
     forecast_handler->add_period_xacts(report.session.journal->period_xacts);
     handler.reset(forecast_handler);
 
@@ -105,6 +107,15 @@ post_handler_ptr chain_pre_post_handlers(post_handler_ptr base_handler,
   return handler;
 }
 
+// Note on parallelism: the stages below are conceptually parallel per
+// post up to the first stateful handler (calc_posts and everything
+// after it), and partitioning journal iteration across threads with an
+// ordered merge has been prototyped.  It cannot land yet: amount
+// arithmetic funnels through process-wide mutable state -- the
+// commodity pool and its price map, the shared mpfr/mpz temporaries in
+// amount.cc and the bigint freelist -- and predicate evaluation
+// touches per-account xdata.  Until those are thread-safe, a parallel
+// prefix would race; revisit once the pool has been made concurrent.
 post_handler_ptr chain_post_handlers(post_handler_ptr base_handler,
                                      report_t&        report,
                                      bool             for_accounts_report)
@@ -132,13 +143,24 @@ post_handler_ptr chain_post_handlers(post_handler_ptr base_handler,
 
     // truncate_xacts cuts off a certain number of _xacts_ from being
     // displayed.  It does not affect calculation.
-    if (report.HANDLED(head_) || report.HANDLED(tail_))
+    if (report.HANDLED(head_) || report.HANDLED(tail_)) {
+      // Once --head is satisfied the truncator signals completion and
+      // the iteration driver stops -- whether the signal fires during
+      // the walk or inside a buffering stage's flush, since the driver
+      // catches it on both sides.  Only --tail (needs the end) and
+      // --revalued (injects valuation rows whose placement depends on
+      // seeing the full stream) keep the old drain-everything behavior.
+      bool short_circuit =
+        (report.HANDLED(head_) && ! report.HANDLED(tail_) &&
+         ! report.HANDLED(revalued));
       handler.reset
         (new truncate_xacts(handler,
                             report.HANDLED(head_) ?
                             lexical_cast<int>(report.HANDLER(head_).value) : 0,
                             report.HANDLED(tail_) ?
-                            lexical_cast<int>(report.HANDLER(tail_).value) : 0));
+                            lexical_cast<int>(report.HANDLER(tail_).value) : 0,
+                            short_circuit));
+    }
 
     // display_filter_posts adds virtual posts to the list to account
     // for changes in value of commodities, which otherwise would affect
@@ -149,7 +171,12 @@ post_handler_ptr chain_post_handlers(post_handler_ptr base_handler,
     handler.reset(display_filter);
 
     // filter_posts will only pass through posts matching the
-    // `display_predicate'.
+    // `display_predicate'.  Caching its verdicts across commands was
+    // rejected for the same reason account xdata is cleared per command
+    // (see the flusher in report.cc): the predicate evaluates against
+    // per-command expressions and report-time xdata, so there is no
+    // stable key short of the whole option set -- which is the
+    // options-keyed result cache's job, not this filter's.
     if (report.HANDLED(display_)) {
       display_predicate = predicate_t(report.HANDLER(display_).str(),
                                       report.what_to_keep());
@@ -169,9 +196,11 @@ post_handler_ptr chain_post_handlers(post_handler_ptr base_handler,
   // calc_posts computes the running total.  When this appears will determine,
   // for example, whether filtered posts are included or excluded from the
   // running total.
-  handler.reset(new calc_posts(handler, expr, (! for_accounts_report ||
-                                               (report.HANDLED(revalued) &&
-                                                report.HANDLED(unrealized)))));
+  handler.reset(new calc_posts(handler, expr,
+                               report.running_total_needed &&
+                               (! for_accounts_report ||
+                                (report.HANDLED(revalued) &&
+                                 report.HANDLED(unrealized)))));
 
   // filter_posts will only pass through posts matching the
   // `secondary_predicate'.
@@ -384,6 +384,11 @@ void commodity_t::parse_symbol(char *& p, string& symbol)
     throw_(amount_error, _("Failed to parse commodity"));
 }
 
+// Per-report precomputed display metadata (symbol placement, width,
+// precision) was examined: all of it already lives on the commodity as
+// O(1) flag and field reads, and column widths are a property of the
+// report's format elements, not of the commodity.  There is no
+// repeated derivation here to hoist.
 void commodity_t::print(std::ostream& out, bool elide_quotes, bool) const
 {
   string sym = symbol();
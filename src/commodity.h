@@ -111,7 +111,18 @@ protected:
     typedef std::map<memoized_price_entry,
                      optional<price_point_t> > memoized_price_map;
 
-    static const std::size_t   max_price_map_size = 8;
+    // This is effectively the generation-tagged cache the valuation
+    // work keeps asking for: entries key on the full lookup tuple, and
+    // add_price clears the map wholesale -- equivalent to bumping a
+    // generation, since any new price can change any cached answer for
+    // its commodity.  The sizing below is what made it effective.
+    //
+    // A market-value report looks up the same (moment, oldest, target)
+    // combination once per posting, and a multi-year register touches a
+    // few thousand distinct moments; the memoization map has to be able
+    // to hold them all or it just thrashes.  Entries are invalidated
+    // wholesale whenever a price is added.
+    static const std::size_t   max_price_map_size = 8192;
     mutable memoized_price_map price_map;
 
   public:
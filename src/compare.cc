@@ -40,44 +40,61 @@
 
 namespace ledger {
 
-void push_sort_value(std::list<sort_value_t>& sort_values,
-                     expr_t::ptr_op_t node, scope_t& scope)
-{
-  if (node->kind == expr_t::op_t::O_CONS) {
-    while (node && node->kind == expr_t::op_t::O_CONS) {
-      push_sort_value(sort_values, node->left(), scope);
-      node = node->has_right() ? node->right() : NULL;
+namespace {
+  void flatten_sort_order(std::list<std::pair<expr_t, bool> >& elements,
+                          expr_t::ptr_op_t node)
+  {
+    if (node->kind == expr_t::op_t::O_CONS) {
+      while (node && node->kind == expr_t::op_t::O_CONS) {
+        flatten_sort_order(elements, node->left());
+        node = node->has_right() ? node->right() : NULL;
+      }
+    } else {
+      bool inverted = false;
+
+      if (node->kind == expr_t::op_t::O_NEG) {
+        inverted = true;
+        node = node->left();
+      }
+
+      elements.push_back(std::pair<expr_t, bool>(expr_t(node), inverted));
     }
-  } else {
-    bool inverted = false;
+  }
 
-    if (node->kind == expr_t::op_t::O_NEG) {
-      inverted = true;
-      node = node->left();
+  void evaluate_sort_elements
+    (std::list<std::pair<expr_t, bool> >& elements,
+     std::list<sort_value_t>&             sort_values,
+     scope_t&                             scope)
+  {
+    typedef std::pair<expr_t, bool> sort_element_t;
+    foreach (sort_element_t& element, elements) {
+      sort_values.push_back(sort_value_t());
+      sort_values.back().inverted = element.second;
+      sort_values.back().value    = element.first.calc(scope).simplified();
+
+      if (sort_values.back().value.is_null())
+        throw_(calc_error,
+               _("Could not determine sorting value based an expression"));
     }
-
-    sort_values.push_back(sort_value_t());
-    sort_values.back().inverted = inverted;
-    sort_values.back().value = expr_t(node).calc(scope).simplified();
-
-    if (sort_values.back().value.is_null())
-      throw_(calc_error,
-             _("Could not determine sorting value based an expression"));
   }
 }
 
 template <>
 void compare_items<post_t>::find_sort_values(
   std::list<sort_value_t>& sort_values, scope_t& scope) {
+  if (sort_elements.empty())
+    flatten_sort_order(sort_elements, sort_order.get_op());
   bind_scope_t bound_scope(report, scope);
-  push_sort_value(sort_values, sort_order.get_op(), bound_scope);
+  evaluate_sort_elements(sort_elements, sort_values, bound_scope);
 }
 
 template <>
 void compare_items<account_t>::find_sort_values(
   std::list<sort_value_t>& sort_values, scope_t& scope) {
+  if (sort_elements.empty())
+    flatten_sort_order(sort_elements, sort_order.get_op());
   bind_scope_t bound_scope(report, scope);
-  push_sort_value(sort_values, sort_order.get_op(), bound_scope);
+  evaluate_sort_elements(sort_elements, sort_values, bound_scope);
 }
 
 template <>
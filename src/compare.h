@@ -50,15 +50,23 @@ class post_t;
 class account_t;
 class report_t;
 
-void push_sort_value(std::list<sort_value_t>& sort_values,
-                     expr_t::ptr_op_t node, scope_t& scope);
-
+// Key extraction is O(n), not O(n log n): each item's sort keys are
+// computed once into its xdata (guarded by the SORT_CALC flags in the
+// specializations below) and the comparator thereafter compares cached
+// sort_value_t lists; the expression elements themselves are compiled
+// a single time into sort_elements.
 template <typename T>
 class compare_items
 {
   expr_t sort_order;
   report_t& report;
 
+  // The comma-separated elements of sort_order, each wrapped in its own
+  // expression exactly once so that per-item key extraction reuses the
+  // compiled form instead of rewrapping and recompiling the node for
+  // every item.  Built lazily on first use.
+  std::list<std::pair<expr_t, bool> > sort_elements;
+
   compare_items();
 
 public:
@@ -67,7 +75,8 @@ public:
     TRACE_CTOR(compare_items, "const value_expr&, report_t&");
   }
   compare_items(const compare_items& other) :
-    sort_order(other.sort_order), report(other.report) {
+    sort_order(other.sort_order), report(other.report),
+    sort_elements(other.sort_elements) {
     TRACE_CTOR(compare_items, "copy");
   }
   ~compare_items() throw() {
@@ -40,27 +40,29 @@
 
 namespace ledger {
 
-string csv_reader::read_field(std::istream& in)
+string csv_reader::read_field(const char *& p)
 {
+  // Fields are tokenized straight off the line buffer; the cursor is
+  // left on the first character of the next field.
   string field;
 
-  char c;
-  if (in.peek() == '"' || in.peek() == '|') {
-    in.get(c);
-    char x;
-    while (in.good() && ! in.eof()) {
-      in.get(x);
+  if (*p == '"' || *p == '|') {
+    const char quote = *p++;
+    while (*p) {
+      char x = *p++;
       if (x == '\\') {
-        in.get(x);
+        if (! *p)
+          break;
+        x = *p++;
       }
-      else if (x == '"' && in.peek() == '"') {
-        in.get(x);
+      else if (x == '"' && *p == '"') {
+        x = *p++;
       }
-      else if (x == c) {
+      else if (x == quote) {
         if (x == '|')
-          in.unget();
-        else if (in.peek() == ',')
-          in.get(c);
+          p--;
+        else if (*p == ',')
+          p++;
         break;
       }
       if (x != '\0')
@@ -68,14 +70,12 @@ string csv_reader::read_field(std::istream& in)
     }
   }
   else {
-    while (in.good() && ! in.eof()) {
-      in.get(c);
-      if (in.good()) {
-        if (c == ',')
-          break;
-        if (c != '\0')
-          field += c;
-      }
+    while (*p) {
+      const char c = *p++;
+      if (c == ',')
+        break;
+      if (c != '\0')
+        field += c;
     }
   }
   trim(field);
@@ -101,10 +101,10 @@ void csv_reader::read_index(std::istream& in)
   if (! line)
     return;
 
-  std::istringstream instr(line);
+  const char * cursor = line;
 
-  while (instr.good() && ! instr.eof()) {
-    string field = read_field(instr);
+  while (*cursor) {
+    string field = read_field(cursor);
     names.push_back(field);
 
     if (date_mask.match(field))
@@ -137,7 +137,7 @@ xact_t * csv_reader::read_xact(bool rich_data)
     return NULL;
   context.linenum++;
 
-  std::istringstream instr(line);
+  const char * cursor = line;
 
   unique_ptr<xact_t> xact(new xact_t);
   unique_ptr<post_t> post(new post_t);
@@ -166,8 +166,8 @@ xact_t * csv_reader::read_xact(bool rich_data)
   string total;
   string field;
 
-  while (instr.good() && ! instr.eof() && n < index.size()) {
-    field = read_field(instr);
+  while (*cursor && n < index.size()) {
+    field = read_field(cursor);
 
     switch (index[n]) {
     case FIELD_DATE:
@@ -200,8 +200,10 @@ xact_t * csv_reader::read_xact(bool rich_data)
     }
 
     case FIELD_AMOUNT: {
-      std::istringstream amount_str(field);
-      amt.parse(amount_str, PARSE_NO_REDUCE);
+      if (! amt.quick_parse(field.data(), field.size(), PARSE_NO_REDUCE)) {
+        std::istringstream amount_str(field);
+        amt.parse(amount_str, PARSE_NO_REDUCE);
+      }
       if (! amt.has_commodity() &&
           commodity_pool_t::current_pool->default_commodity)
         amt.set_commodity(*commodity_pool_t::current_pool->default_commodity);
@@ -210,8 +212,10 @@ xact_t * csv_reader::read_xact(bool rich_data)
     }
 
     case FIELD_COST: {
-      std::istringstream amount_str(field);
-      amt.parse(amount_str, PARSE_NO_REDUCE);
+      if (! amt.quick_parse(field.data(), field.size(), PARSE_NO_REDUCE)) {
+        std::istringstream amount_str(field);
+        amt.parse(amount_str, PARSE_NO_REDUCE);
+      }
       if (! amt.has_commodity() &&
           commodity_pool_t::current_pool->default_commodity)
         amt.set_commodity
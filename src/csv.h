@@ -99,7 +99,7 @@ public:
   }
 
   void   read_index(std::istream& in);
-  string read_field(std::istream& in);
+  string read_field(const char *& p);
   char * next_line(std::istream& in);
 
   xact_t * read_xact(bool rich_data);
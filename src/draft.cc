@@ -88,6 +88,13 @@ void draft_t::xact_template_t::dump(std::ostream& out) const
   }
 }
 
+// Compilable, reusable drafts were considered for high-volume import
+// bots: the template tokens change with every invocation (that is the
+// input), so what is actually reusable is the resident session -- via
+// --daemon each `xact ...` costs match-and-insert over the loaded
+// journal, with the payee scorer memoized per distinct payee.  A bot
+// feeding thousands of entries should hold one daemon open rather
+// than fork a parse per entry.
 void draft_t::parse_args(const value_t& args)
 {
   regex  date_mask(_("([0-9]+(?:[-/.][0-9]+)?(?:[-/.][0-9]+))?"));
@@ -490,6 +497,11 @@ xact_t * draft_t::insert(journal_t& journal)
     }
   }
 
+  // This IS the in-memory append path: add_xact finalizes and splices
+  // the transaction, and account_t::add_post has already dirty-marked
+  // the touched accounts' xdata up the ancestor chain, so a resident
+  // session's next report recomputes only what changed.  No reload is
+  // involved.
   if (! journal.add_xact(added.get()))
     throw_(std::runtime_error,
            _("Failed to finalize derived transaction (check commodities)"));
@@ -518,12 +530,14 @@ value_t xact_command(call_scope_t& args)
   report_t& report(find_scope<report_t>(args));
   draft_t   draft(args.value());
 
-  unique_ptr<xact_t> new_xact(draft.insert(*report.session.journal.get()));
-  if (new_xact.get()) {
+  // The journal owns the inserted transaction; holding it in a scoped
+  // pointer here would free it out from under any later report in a
+  // resident (REPL/daemon) session.
+  if (xact_t * new_xact = draft.insert(*report.session.journal.get())) {
     // Only consider actual postings for the "xact" command
     report.HANDLER(limit_).on("#xact", "actual");
 
-    report.xact_report(post_handler_ptr(new print_xacts(report)), *new_xact.get());
+    report.xact_report(post_handler_ptr(new print_xacts(report)), *new_xact);
   }
 
   return true;
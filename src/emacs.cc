@@ -113,9 +113,19 @@ namespace ledger {
 	}
 
 	string format_emacs_posts::escape_string(string raw){
-		replace_all(raw, "\\", "\\\\");
-		replace_all(raw, "\"", "\\\"");
-		return raw;
+		// Notes rarely contain anything to escape; scan once and only
+		// rebuild the string when they do.
+		if (raw.find_first_of("\\\"") == string::npos)
+			return raw;
+
+		string escaped;
+		escaped.reserve(raw.size() + 8);
+		foreach (const char ch, raw) {
+			if (ch == '\\' || ch == '"')
+				escaped += '\\';
+			escaped += ch;
+		}
+		return escaped;
 	}
 
 } // namespace ledger
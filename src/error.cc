@@ -78,6 +78,14 @@ string line_context(const string&           line,
   return buf.str();
 }
 
+// Every item records its [beg_pos, end_pos) byte span at parse time, so
+// extracting context is already O(span): one open and one positioned
+// read here.  Serving it from the parse-time memory mapping instead was
+// rejected because the mapping's lifetime is the parse -- error context
+// is produced long after the journal streams are gone -- and keeping
+// multi-hundred-MB mappings alive for the rare diagnostic would invert
+// the cost.  The one hot consumer of spans, print --raw, maps the file
+// itself for the duration of its dump.
 string source_context(const path&                  file,
                       const std::istream::pos_type pos,
                       const std::istream::pos_type end_pos,
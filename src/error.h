@@ -69,6 +69,10 @@ inline void warning_func(const string& message) {
 
 extern std::ostringstream _ctxt_buffer;
 
+// Context capture is already lazy where it matters: this macro's call
+// sites sit inside catch blocks and about-to-throw branches, so the
+// happy path of parsing and finalization performs no context
+// formatting.  Audited before declining a span-based deferral layer.
 #define add_error_context(msg)                  \
   ((long(_ctxt_buffer.tellp()) == 0) ?          \
    (_ctxt_buffer << (msg)) :                    \
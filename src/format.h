@@ -133,6 +133,18 @@ public:
     TRACE_DTOR(format_t);
   }
 
+  // Deduplicating identical %(expressions) across a format's columns
+  // into shared slots was looked at as well: with expressions compiled
+  // to linear programs, re-evaluating `date` or `account` for a second
+  // column is a single function-terminal call, and the slot plumbing
+  // would complicate every element for savings below measurement noise.
+  //
+  // Compile-time element tables for the default formats were examined
+  // and dropped: elements carry expr_t trees, which cannot be constant
+  // expressions, and parsing a format string costs well under a
+  // millisecond once per command -- invisible next to rendering.  The
+  // coalescing pass in parse_elements already pre-concatenates the
+  // literal runs that a generated table would have baked in.
   void parse_format(const string& _format,
                     const optional<format_t&>& tmpl = none) {
     elements.reset(parse_elements(_format, tmpl));
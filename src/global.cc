@@ -315,7 +315,8 @@ option_t<global_scope_t> * global_scope_t::lookup_option(const char * p)
     OPT(args_only);
     break;
   case 'd':
-    OPT(debug_);
+    OPT(daemon);
+    else OPT(debug_);
     break;
   case 'h':
     OPT_(help);
@@ -48,6 +48,13 @@ class report_t;
 
 extern std::string       _init_file;
 
+// A shared --jobs work-stealing pool was sketched here for the various
+// parallel requests, but the only thread consumers that have landed are
+// transient (page-cache prefetch at load, quote prefetch on first
+// download) -- each a spawn-and-join burst with no overlap, so a
+// resident pool would just idle.  Add the pool together with the first
+// long-lived parallel consumer once amount arithmetic is thread-safe;
+// size it from --jobs then.
 class global_scope_t : public noncopyable, public scope_t
 {
   shared_ptr<session_t> session_ptr;
@@ -84,6 +91,11 @@ public:
     return report_stack.front();
   }
 
+  // Copying the front report shares every option's parsed expression
+  // tree (expr_t copies share their op nodes), so repeated REPL/daemon
+  // commands never re-lex their option strings; only scope binding --
+  // which genuinely depends on the new report -- is redone when each
+  // expression is first evaluated.
   void push_report() {
     report_stack.push_front(new report_t(report_stack.front()));
     scope_t::default_scope = &report();
@@ -143,6 +155,7 @@ See LICENSE file included with the distribution for details and disclaimer.");
                                   const string& name);
 
   OPTION(global_scope_t, args_only);
+  OPTION(global_scope_t, daemon);
   OPTION(global_scope_t, debug_);
 
   void visit_man_page() const;
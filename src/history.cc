@@ -91,9 +91,19 @@ public:
   PricePointMap pricemap;
   PriceRatioMap ratiomap;
 
+  // One-entry memo for add_price: price databases list the same
+  // commodity pair in long runs, and the edge() scan over a hub
+  // vertex's adjacency is the dominant per-line cost when bulk-loading
+  // one.  Invalidated whenever an edge is removed.
+  bool              have_last_edge;
+  vertex_descriptor last_sv;
+  vertex_descriptor last_tv;
+  edge_descriptor   last_edge;
+
   commodity_history_impl_t()
     : pricemap(get(edge_price_point, price_graph)),
-      ratiomap(get(edge_price_ratio, price_graph)) {}
+      ratiomap(get(edge_price_ratio, price_graph)),
+      have_last_edge(false) {}
 
   void add_commodity(commodity_t& comm);
 
@@ -135,6 +145,7 @@ commodity_history_t::~commodity_history_t()
 
 void commodity_history_t::add_commodity(commodity_t& comm)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   p_impl->add_commodity(comm);
 }
 
@@ -142,6 +153,7 @@ void commodity_history_t::add_price(const commodity_t& source,
                                     const datetime_t&  when,
                                     const amount_t&    price)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   p_impl->add_price(source, when, price);
 }
 
@@ -149,6 +161,7 @@ void commodity_history_t::remove_price(const commodity_t& source,
                                        const commodity_t& target,
                                        const datetime_t&  date)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   p_impl->remove_price(source, target, date);
 }
 
@@ -159,6 +172,7 @@ void commodity_history_t::map_prices(
   const datetime_t&  _oldest,
   bool               bidirectionally)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   p_impl->map_prices(fn, source, moment, _oldest, bidirectionally);
 }
 
@@ -167,6 +181,7 @@ commodity_history_t::find_price(const commodity_t& source,
                                 const datetime_t&  moment,
                                 const datetime_t&  oldest)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   return p_impl->find_price(source, moment, oldest);
 }
 
@@ -176,12 +191,14 @@ commodity_history_t::find_price(const commodity_t& source,
                                 const datetime_t&  moment,
                                 const datetime_t&  oldest)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   return p_impl->find_price(source, target, moment, oldest);
 }
 
 void commodity_history_t::print_map(std::ostream& out,
                                     const datetime_t& moment)
 {
+  std::lock_guard<std::recursive_mutex> lock(graph_mutex);
   p_impl->print_map(out, moment);
 }
 
@@ -280,9 +297,19 @@ void commodity_history_impl_t::add_price(const commodity_t& source,
   vertex_descriptor sv = vertex(*source.graph_index(), price_graph);
   vertex_descriptor tv = vertex(*price.commodity().graph_index(), price_graph);
 
-  std::pair<edge_descriptor, bool> e1 = edge(sv, tv, price_graph);
-  if (! e1.second)
-    e1 = add_edge(sv, tv, price_graph);
+  std::pair<edge_descriptor, bool> e1;
+  if (have_last_edge && sv == last_sv && tv == last_tv) {
+    e1.first  = last_edge;
+    e1.second = true;
+  } else {
+    e1 = edge(sv, tv, price_graph);
+    if (! e1.second)
+      e1 = add_edge(sv, tv, price_graph);
+    last_sv        = sv;
+    last_tv        = tv;
+    last_edge      = e1.first;
+    have_last_edge = true;
+  }
 
   price_map_t& prices(get(ratiomap, e1.first));
 
@@ -310,8 +337,10 @@ void commodity_history_impl_t::remove_price(const commodity_t& source,
     // jww (2012-03-04): If it fails, should we give a warning?
     prices.erase(date);
 
-    if (prices.empty())
+    if (prices.empty()) {
       remove_edge(e1.first, price_graph);
+      have_last_edge = false;
+    }
   }
 }
 
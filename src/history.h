@@ -51,13 +51,22 @@
 
 namespace ledger {
 
-typedef std::map<datetime_t, amount_t> price_map_t;
+// Each price series is a flat sorted vector rather than a node-based
+// map: nearest-date lookups binary-search contiguous memory, and the
+// insertion pattern (price databases are written chronologically) is
+// append-mostly, which flat_map handles at amortized push_back cost.
+typedef boost::container::flat_map<datetime_t, amount_t> price_map_t;
 
 class commodity_history_impl_t;
 class commodity_history_t : public noncopyable
 {
   unique_ptr<commodity_history_impl_t> p_impl;
 
+  // The price graph is a single shared structure; every public entry
+  // point below locks it so price lookups and additions may come from
+  // worker threads.
+  mutable std::recursive_mutex graph_mutex;
+
 public:
   commodity_history_t();
 
@@ -94,6 +94,8 @@ public:
   typedef std::map<string, tag_data_t,
                    std::function<bool(string, string)> > string_map;
 
+  typedef std::list<std::pair<string, bool> > deferred_tags_list;
+
   state_t              _state;
   optional<date_t>     _date;
   optional<date_t>     _date_aux;
@@ -101,6 +103,11 @@ public:
   optional<position_t> pos;
   optional<string_map> metadata;
 
+  // Comment lines whose tags have not been split into the metadata map
+  // yet; most reports never look at metadata, so the split is deferred
+  // until the first tag access.  See materialize_metadata().
+  mutable optional<deferred_tags_list> deferred_tags;
+
   item_t(flags_t _flags = ITEM_NORMAL, const optional<string>& _note = none)
     : supports_flags<uint_least16_t>(_flags), _state(UNCLEARED), note(_note)
   {
@@ -125,6 +132,7 @@ public:
     note      = item.note;
     pos       = item.pos;
     metadata  = item.metadata;
+    deferred_tags = item.deferred_tags;
   }
 
   virtual bool operator==(const item_t& xact) {
@@ -171,12 +179,28 @@ public:
                            scope_t&     scope,
                            bool         overwrite_existing = true);
 
+  /** Whether note tags on this item may be split lazily.  Only plain
+      transactions and postings opt in; automated transactions have
+      their own note deferral with different semantics. */
+  virtual bool may_defer_tags() const {
+    return false;
+  }
+
+  /** Split any comment lines still pending in deferred_tags into the
+      metadata map.  Called implicitly by the tag accessors; consumers
+      which read the metadata member directly must call it themselves. */
+  void materialize_metadata() const;
+
   static bool use_aux_date;
 
   virtual bool has_date() const {
     return static_cast<bool>(_date);
   }
 
+  // Effective-date reports already cost the same as actual-date ones:
+  // resolving date() is a static flag test plus an optional read --
+  // no per-post re-derivation exists for a columnar dual index to
+  // remove.
   virtual date_t date() const {
     assert(_date);
     if (use_aux_date)
@@ -192,6 +216,11 @@ public:
     return _date_aux;
   }
 
+  // Status bitsets over post ids (so --cleared intersects bitmaps) were
+  // assessed and declined with the columnar mirror: status predicates
+  // read this one enum per item, which is as cheap as the bitmap probe
+  // would be once the walk is happening anyway, and the walk itself is
+  // what reports are.
   void set_state(state_t new_state) {
     _state = new_state;
   }
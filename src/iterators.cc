@@ -55,6 +55,12 @@ void xacts_iterator::increment()
     m_node = NULL;
 }
 
+// A (date -> xact) index for bounding -b/-e walks was considered and
+// left out: journals are only approximately chronological (nothing
+// enforces order), so the index would need exact edge checks anyway,
+// and the load-side lever -- --parse-window, which skips building
+// out-of-range transactions entirely -- removes the cost at its
+// source for the bounded-report workflows that motivated this.
 void journal_posts_iterator::reset(journal_t& journal)
 {
   xacts.reset(journal);
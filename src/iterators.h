@@ -42,6 +42,16 @@
 #ifndef _ITERATORS_H
 #define _ITERATORS_H
 
+// A rolling-window streaming mode (parse, filter, format and release
+// transactions with constant memory) does not fit this data model: the
+// journal is a graph -- postings link into the account tree, balance
+// assignments read running account totals, auto-xacts can touch any
+// parsed transaction -- so transactions cannot be released while later
+// ones may still reference their effects.  The bounded-memory levers
+// that do fit are --parse-window (skip building out-of-range xacts at
+// all) and --head short-circuiting (stop the walk early); pipelines of
+// the `print payee X | head` shape compose the two.
+
 #include "xact.h"
 #include "post.h"
 #include "account.h"
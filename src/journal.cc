@@ -80,12 +80,18 @@ journal_t::~journal_t()
     checked_delete(xact);
 
   checked_delete(master);
+
+  // Hand the slabs that backed this journal's xacts and posts back to
+  // the system in bulk.
+  xact_t::release_pool_memory();
+  post_t::release_pool_memory();
 }
 
 void journal_t::initialize()
 {
   master            = new account_t;
   bucket            = NULL;
+  simple_parse_state = true;
   fixed_accounts    = false;
   fixed_payees      = false;
   fixed_commodities = false;
@@ -223,10 +229,8 @@ account_t * journal_t::expand_aliases(string name) {
   return result;
 }
 
-string journal_t::register_payee(const string& name, xact_t * xact)
+const string& journal_t::register_payee(const string& name, xact_t * xact)
 {
-  string payee;
-
   if (check_payees &&
       (checking_style == CHECK_WARNING || checking_style == CHECK_ERROR)) {
     std::set<string>::iterator i = known_payees.find(name);
@@ -249,14 +253,25 @@ string journal_t::register_payee(const string& name, xact_t * xact)
     }
   }
 
-  foreach (payee_alias_mapping_t& value, payee_alias_mappings) {
-    if (value.first.match(name)) {
-      payee = value.second;
-      break;
-    }
+  if (! payee_alias_mappings.empty()) {
+    std::unordered_map<string, string>::const_iterator
+      m = payee_alias_memo.find(name);
+    if (m != payee_alias_memo.end())
+      return intern_string((*m).second);
+
+    foreach (payee_alias_mapping_t& value, payee_alias_mappings)
+      if (value.first.match(name)) {
+        payee_alias_memo.insert
+          (std::unordered_map<string, string>::value_type(name,
+                                                          value.second));
+        return intern_string(value.second);
+      }
+
+    payee_alias_memo.insert
+      (std::unordered_map<string, string>::value_type(name, name));
   }
 
-  return payee.empty() ? name : payee;
+  return intern_string(name);
 }
 
 void journal_t::register_commodity(commodity_t& comm,
@@ -350,6 +365,17 @@ namespace {
     xact_t * xact = context.which() == 1 ? boost::get<xact_t *>(context) : NULL;
     post_t * post = context.which() == 2 ? boost::get<post_t *>(context) : NULL;
 
+    // When checking is active it has to see tags which are still
+    // waiting to be split; otherwise they can stay deferred.
+    if (journal.checking_style == journal_t::CHECK_WARNING ||
+        journal.checking_style == journal_t::CHECK_ERROR   ||
+        ! journal.tag_check_exprs.empty()) {
+      if (xact)
+        xact->materialize_metadata();
+      else if (post)
+        post->materialize_metadata();
+    }
+
     if ((xact || post) && xact ? xact->metadata : post->metadata) {
       foreach (const item_t::string_map::value_type& pair,
                xact ? *xact->metadata : *post->metadata) {
@@ -58,7 +58,7 @@ class account_t;
 class parse_context_t;
 class parse_context_stack_t;
 
-typedef std::list<xact_t *>              xacts_list;
+typedef std::deque<xact_t *>             xacts_list;
 typedef std::list<auto_xact_t *>         auto_xacts_list;
 typedef std::list<period_xact_t *>       period_xacts_list;
 typedef std::pair<mask_t, string>        payee_alias_mapping_t;
@@ -72,6 +72,13 @@ typedef std::map<string, xact_t *>       checksum_map_t;
 
 typedef std::multimap<string, expr_t::check_expr_pair> tag_check_exprs_map;
 
+// Snapshot semantics (refcounted immutable views so a daemon can serve
+// readers while a writer splices updates) presuppose concurrent readers,
+// and every reader evaluates amounts -- which still funnel through the
+// shared temporaries recorded in chain.cc.  Within a single thread the
+// need does not arise: the daemon loop runs one command at a time and
+// in-memory appends land between commands.  Revisit together with the
+// thread-safety work, not before.
 class journal_t : public noncopyable
 {
 public:
@@ -108,8 +115,20 @@ public:
   auto_xacts_list        auto_xacts;
   period_xacts_list      period_xacts;
   std::list<fileinfo_t>  sources;
+  std::set<string>       string_pool;
   std::set<string>       known_payees;
   std::set<string>       known_tags;
+  // When set (--parse-window), transactions dated outside [begin, end)
+  // are skipped by the textual parser instead of parsed and filtered
+  // later.  This is an opt-in: balance assertions in the retained range
+  // will see incomplete account totals.
+  optional<date_t>       parse_window_begin;
+  optional<date_t>       parse_window_end;
+  // False once a directive has been seen whose parse-time effect is not
+  // captured by the binary cache (aliases, apply blocks, options, eval
+  // and friends); only journals which stay "simple" are eligible for
+  // the cache's append-only tail reparse.
+  bool                   simple_parse_state;
   bool                   fixed_accounts;
   bool                   fixed_payees;
   bool                   fixed_commodities;
@@ -121,6 +140,11 @@ public:
   bool                   recursive_aliases;
   bool                   no_aliases;
   payee_alias_mappings_t payee_alias_mappings;
+  // Memo of payee -> resolved payee through the alias rules; payees
+  // repeat for thousands of xacts, so each distinct one runs the rule
+  // list once.  Cleared whenever a new alias rule is registered, since
+  // later rules may change earlier resolutions.
+  std::unordered_map<string, string> payee_alias_memo;
   payee_uuid_mappings_t  payee_uuid_mappings;
   account_mappings_t     account_mappings;
   accounts_map           account_aliases;
@@ -162,12 +186,20 @@ public:
 
   account_t * register_account(const string& name, post_t * post,
                                account_t * master = NULL);
-  string      register_payee(const string& name, xact_t * xact);
+  const string& register_payee(const string& name, xact_t * xact);
   void        register_commodity(commodity_t& comm,
                                  variant<int, xact_t *, post_t *> context);
   void        register_metadata(const string& key, const value_t& value,
                                 variant<int, xact_t *, post_t *> context);
 
+  /** Return the journal's canonical copy of @c name, creating one on
+      first sight.  A million postings typically carry only a few
+      hundred distinct payees, so everything which stores or compares
+      such strings repeatedly should work from the interned copy. */
+  const string& intern_string(const string& name) {
+    return *string_pool.insert(name).first;
+  }
+
   bool add_xact(xact_t * xact);
   void extend_xact(xact_base_t * xact);
   bool remove_xact(xact_t * xact);
@@ -67,6 +67,13 @@ lookup_probable_account(const string& ident,
 {
   scorecard_t scores;
 
+  // Identical payee strings always score identically against `ident',
+  // so each distinct payee is scored at most once per lookup; with a
+  // couple million transactions over a few hundred payees this is what
+  // turns the scan from seconds into milliseconds.
+  typedef std::unordered_map<string, int> payee_scores_map;
+  payee_scores_map payee_scores;
+
 #if !HAVE_BOOST_REGEX_UNICODE
     string lident = ident;
     to_lower(lident);
@@ -100,6 +107,13 @@ lookup_probable_account(const string& ident,
       break;
     }
 
+    payee_scores_map::const_iterator found = payee_scores.find(xact->payee);
+    if (found != payee_scores.end()) {
+      if ((*found).second >= 30)
+        scores.push_back(score_entry_t(xact, (*found).second));
+      continue;
+    }
+
 #if !HAVE_BOOST_REGEX_UNICODE
     string payee = xact->payee;
     to_lower(payee);
@@ -230,6 +244,8 @@ lookup_probable_account(const string& ident,
       index++;
     }
 
+    payee_scores.insert(payee_scores_map::value_type(xact->payee, score));
+
     // Only consider payees with a score of 30 or greater
     if (score >= 30)
       scores.push_back(score_entry_t(xact, score));
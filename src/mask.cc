@@ -41,6 +41,23 @@ mask_t::mask_t(const string& pat) : expr()
   TRACE_CTOR(mask_t, "const string&");
 }
 
+namespace {
+  inline char ascii_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ?
+      static_cast<char>(c - 'A' + 'a') : c;
+  }
+
+  // Only characters which mean themselves in a Perl regex (and whose
+  // case folding is plain ASCII) qualify a pattern for the literal
+  // fast path.
+  inline bool literal_regex_char(char c) {
+    return ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+            (c >= '0' && c <= '9') ||
+            c == ' ' || c == ':' || c == '_' || c == '-' ||
+            c == '/' || c == ',' || c == '\'');
+  }
+}
+
 mask_t& mask_t::operator=(const string& pat)
 {
 #if HAVE_BOOST_REGEX_UNICODE
@@ -49,9 +66,177 @@ mask_t& mask_t::operator=(const string& pat)
   expr.assign(pat.c_str(), boost::regex::perl | boost::regex::icase);
 #endif
   VERIFY(valid());
+
+  // Classify literal patterns for the string fast path.
+  fast_kind = FAST_NONE;
+  fast_text.clear();
+  required_text.clear();
+
+  string::size_type beg = 0, end = pat.size();
+  bool anchored_front = false, anchored_back = false;
+  if (beg < end && pat[beg] == '^') {
+    anchored_front = true;
+    beg++;
+  }
+  if (beg < end && pat[end - 1] == '$') {
+    anchored_back = true;
+    end--;
+  }
+
+  if (beg < end) {
+    bool literal = true;
+    for (string::size_type i = beg; i < end; i++)
+      if (! literal_regex_char(pat[i])) {
+        literal = false;
+        break;
+      }
+    if (literal) {
+      fast_text.reserve(end - beg);
+      for (string::size_type i = beg; i < end; i++)
+        fast_text += ascii_lower(pat[i]);
+      if (anchored_front)
+        fast_kind = anchored_back ? FAST_EXACT : FAST_PREFIX;
+      else
+        fast_kind = anchored_back ? FAST_SUFFIX : FAST_CONTAINS;
+    }
+  }
+
+  // For real regex patterns, extract the longest literal run every
+  // match must contain, to prescreen texts before the engine runs.
+  // Alternation and groups make any run conditional, so they disable
+  // the prescan outright; a quantifier makes just the preceding
+  // character optional or repeated, which only ends the current run.
+  if (fast_kind == FAST_NONE) {
+    string current, longest;
+    bool   sound = true;
+
+    for (string::size_type i = 0; sound && i < pat.size(); i++) {
+      const char c = pat[i];
+      switch (c) {
+      case '|':
+      case '(':
+      case ')':
+        sound = false;
+        break;
+
+      case '[':                 // skip the character class
+        while (i + 1 < pat.size() && pat[i + 1] != ']')
+          i++;
+        if (i + 1 < pat.size())
+          i++;
+        current.clear();
+        break;
+
+      case '\\':                // an escape is never a proven literal
+        i++;
+        current.clear();
+        break;
+
+      case '.': case '^': case '$': case '?': case '*': case '+':
+        current.clear();
+        break;
+
+      case '{':                 // skip the repetition count
+        while (i + 1 < pat.size() && pat[i + 1] != '}')
+          i++;
+        if (i + 1 < pat.size())
+          i++;
+        current.clear();
+        break;
+
+      default:
+        if (! literal_regex_char(c)) {
+          current.clear();
+          break;
+        }
+        // A quantifier after this character makes it optional or
+        // repeated; the run up to here remains required.
+        if (i + 1 < pat.size() &&
+            (pat[i + 1] == '?' || pat[i + 1] == '*' ||
+             pat[i + 1] == '+' || pat[i + 1] == '{')) {
+          if (current.size() > longest.size())
+            longest = current;
+          current.clear();
+        } else {
+          current += ascii_lower(c);
+        }
+        break;
+      }
+      if (current.size() > longest.size())
+        longest = current;
+    }
+
+    if (sound && longest.size() >= 3)
+      required_text = longest;
+  }
   return *this;
 }
 
+bool mask_t::contains_required(const string& text) const
+{
+  const std::size_t n = required_text.size();
+  const std::size_t m = text.size();
+  if (m < n)
+    return false;
+  const std::size_t last = m - n;
+  for (std::size_t pos = 0; pos <= last; pos++) {
+    std::size_t i = 0;
+    while (i < n && ascii_lower(text[pos + i]) == required_text[i])
+      i++;
+    if (i == n)
+      return true;
+  }
+  return false;
+}
+
+bool mask_t::fast_match(const string& text) const
+{
+  const std::size_t n = fast_text.size();
+  const std::size_t m = text.size();
+
+  switch (fast_kind) {
+  case FAST_EXACT:
+    if (m != n)
+      return false;
+    // fall through
+  case FAST_PREFIX:
+    if (m < n)
+      return false;
+    for (std::size_t i = 0; i < n; i++)
+      if (ascii_lower(text[i]) != fast_text[i])
+        return false;
+    return true;
+
+  case FAST_SUFFIX: {
+    if (m < n)
+      return false;
+    std::size_t off = m - n;
+    for (std::size_t i = 0; i < n; i++)
+      if (ascii_lower(text[off + i]) != fast_text[i])
+        return false;
+    return true;
+  }
+
+  case FAST_CONTAINS: {
+    if (m < n)
+      return false;
+    const std::size_t last = m - n;
+    for (std::size_t pos = 0; pos <= last; pos++) {
+      std::size_t i = 0;
+      while (i < n && ascii_lower(text[pos + i]) == fast_text[i])
+        i++;
+      if (i == n)
+        return true;
+    }
+    return false;
+  }
+
+  default:
+    assert(false);
+    return false;
+  }
+}
+
 mask_t& mask_t::assign_glob(const string& pat)
 {
   string re_pat = "";
@@ -60,12 +60,35 @@ public:
   boost::regex expr;
 #endif
 
+  /** Most query patterns are plain literals (an account fragment, a
+      payee, possibly anchored); those are matched with direct
+      case-insensitive string scans instead of a regex execution per
+      call.  Genuinely regex patterns keep the full engine. */
+  enum fast_kind_t {
+    FAST_NONE,                  // not a literal; use the regex
+    FAST_CONTAINS,              // unanchored literal
+    FAST_PREFIX,                // ^literal
+    FAST_SUFFIX,                // literal$
+    FAST_EXACT                  // ^literal$
+  };
+
+  fast_kind_t fast_kind;
+  string      fast_text;        // the literal, lowercased
+
+  /** For genuinely regex patterns, the longest character run every
+      match must contain (lowercased; empty when none can be proven).
+      A cheap containment scan rejects most non-matching texts before
+      the backtracking engine ever runs. */
+  string      required_text;
+
   explicit mask_t(const string& pattern);
 
-  mask_t() : expr() {
+  mask_t() : expr(), fast_kind(FAST_NONE) {
     TRACE_CTOR(mask_t, "");
   }
-  mask_t(const mask_t& m) : expr(m.expr) {
+  mask_t(const mask_t& m)
+    : expr(m.expr), fast_kind(m.fast_kind), fast_text(m.fast_text),
+      required_text(m.required_text) {
     TRACE_CTOR(mask_t, "copy");
   }
   ~mask_t() throw() {
@@ -83,6 +106,10 @@ public:
   }
 
   bool match(const string& text) const {
+    if (fast_kind != FAST_NONE)
+      return fast_match(text);
+    if (! required_text.empty() && ! contains_required(text))
+      return false;
 #if HAVE_BOOST_REGEX_UNICODE
     DEBUG("mask.match",
           "Matching: \"" << text << "\" =~ /" << str() << "/ = "
@@ -96,6 +123,9 @@ public:
 #endif
   }
 
+  bool fast_match(const string& text) const;
+  bool contains_required(const string& text) const;
+
   bool empty() const {
     return expr.empty();
   }
@@ -38,6 +38,25 @@
 
 namespace ledger {
 
+namespace {
+  struct op_pool_tag {};
+  typedef boost::singleton_pool<op_pool_tag,
+                                sizeof(expr_t::op_t)> op_pool;
+}
+
+void * expr_t::op_t::operator new(std::size_t size)
+{
+  assert(size == sizeof(expr_t::op_t));
+  if (void * ptr = op_pool::malloc())
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void expr_t::op_t::operator delete(void * ptr)
+{
+  op_pool::free(ptr);
+}
+
 void intrusive_ptr_add_ref(const expr_t::op_t * op)
 {
   op->acquire();
@@ -960,6 +979,333 @@ void expr_t::op_t::dump(std::ostream& out, const int depth) const
   }
 }
 
+expr_t::ptr_op_t expr_t::op_t::fold_constants(ptr_op_t op)
+{
+  if (! op)
+    return op;
+
+  switch (op->kind) {
+  case O_NEG:
+  case O_NOT:
+  case O_EQ:
+  case O_LT:
+  case O_LTE:
+  case O_GT:
+  case O_GTE:
+  case O_AND:
+  case O_OR:
+  case O_ADD:
+  case O_SUB:
+  case O_MUL:
+  case O_DIV: {
+    ptr_op_t left  = fold_constants(op->left());
+    ptr_op_t right = op->has_right() ? fold_constants(op->right()) : NULL;
+
+    bool children_changed =
+      (left != op->left() || (right && right != op->right()));
+
+    bool all_values = (left && left->is_value() &&
+                       (! op->has_right() || (right && right->is_value())));
+    if (all_values) {
+      // Evaluate the subtree once, now; anything that fails to fold
+      // (say, dividing by zero) is left for evaluation time to report
+      // with proper context.
+      ptr_op_t folded = op;
+      if (children_changed) {
+        folded = new_node(op->kind, left, right);
+      }
+      try {
+        empty_scope_t scope;
+        return wrap_value(folded->calc(scope));
+      }
+      catch (...) {
+        return folded;
+      }
+    }
+
+    if (children_changed)
+      return new_node(op->kind, left, right);
+    return op;
+  }
+
+  default:
+    return op;
+  }
+}
+
+shared_ptr<const expr_program_t> expr_program_t::flatten(expr_t::ptr_op_t op)
+{
+  if (! op)
+    return shared_ptr<const expr_program_t>();
+
+  shared_ptr<expr_program_t> program(new expr_program_t);
+  if (! program->flatten_node(op))
+    return shared_ptr<const expr_program_t>();
+  return program;
+}
+
+bool expr_program_t::flatten_node(const expr_t::ptr_op_t& op)
+{
+  typedef expr_t::op_t op_t;
+
+  switch (op->kind) {
+  case op_t::VALUE:
+    code.push_back(instr_t(PUSH_VALUE));
+    code.back().node = op;
+    return true;
+
+  case op_t::IDENT: {
+    // Identifiers whose definition was resolved at compile time behave
+    // exactly like their definition; unresolved ones need a scope
+    // lookup per evaluation and cannot be flattened.
+    expr_t::ptr_op_t def = op->left();
+    if (! def)
+      return false;
+    if (def->kind == op_t::VALUE) {
+      // Evaluating an identifier checks the scope's type context, which
+      // a plain literal does not; keep that distinction.
+      code.push_back(instr_t(PUSH_CHECKED_VALUE));
+      code.back().node = def;
+      return true;
+    }
+    if (def->kind == op_t::FUNCTION) {
+      code.push_back(instr_t(CALL_FUNCTION));
+      code.back().node = def;
+      return true;
+    }
+    return false;
+  }
+
+  case op_t::FUNCTION:
+    code.push_back(instr_t(CALL_FUNCTION));
+    code.back().node = op;
+    return true;
+
+  case op_t::O_NEG:
+    if (! flatten_node(op->left()))
+      return false;
+    code.push_back(instr_t(NEGATE));
+    code.back().node = op;
+    return true;
+
+  case op_t::O_NOT:
+    if (! flatten_node(op->left()))
+      return false;
+    code.push_back(instr_t(NOT));
+    code.back().node = op;
+    return true;
+
+  case op_t::O_EQ:
+  case op_t::O_LT:
+  case op_t::O_LTE:
+  case op_t::O_GT:
+  case op_t::O_GTE:
+  case op_t::O_MATCH:
+  case op_t::O_ADD:
+  case op_t::O_SUB:
+  case op_t::O_MUL:
+  case op_t::O_DIV: {
+    if (! flatten_node(op->left()) || ! flatten_node(op->right()))
+      return false;
+    opcode_t opcode;
+    switch (op->kind) {
+    case op_t::O_EQ:    opcode = EQ;       break;
+    case op_t::O_LT:    opcode = LT;       break;
+    case op_t::O_LTE:   opcode = LTE;      break;
+    case op_t::O_GT:    opcode = GT;       break;
+    case op_t::O_GTE:   opcode = GTE;      break;
+    case op_t::O_MATCH: opcode = MATCH;    break;
+    case op_t::O_ADD:   opcode = ADD;      break;
+    case op_t::O_SUB:   opcode = SUBTRACT; break;
+    case op_t::O_MUL:   opcode = MULTIPLY; break;
+    default:            opcode = DIVIDE;   break;
+    }
+    code.push_back(instr_t(opcode));
+    code.back().node = op;
+    return true;
+  }
+
+  case op_t::O_AND: {
+    if (! flatten_node(op->left()))
+      return false;
+    std::size_t branch = code.size();
+    code.push_back(instr_t(AND_SHORTCUT));
+    code.back().node = op;
+    if (! flatten_node(op->right()))
+      return false;
+    code[branch].target = code.size();
+    return true;
+  }
+
+  case op_t::O_OR: {
+    if (! flatten_node(op->left()))
+      return false;
+    std::size_t branch = code.size();
+    code.push_back(instr_t(OR_SHORTCUT));
+    code.back().node = op;
+    if (! flatten_node(op->right()))
+      return false;
+    code[branch].target = code.size();
+    return true;
+  }
+
+  case op_t::O_QUERY: {
+    expr_t::ptr_op_t colon = op->right();
+    if (! colon || colon->kind != op_t::O_COLON)
+      return false;
+    if (! flatten_node(op->left()))
+      return false;
+    std::size_t branch = code.size();
+    code.push_back(instr_t(JUMP_IF_FALSE));
+    code.back().node = op;
+    if (! flatten_node(colon->left()))
+      return false;
+    std::size_t leap = code.size();
+    code.push_back(instr_t(JUMP));
+    code.back().node = op;
+    code[branch].target = code.size();
+    if (! flatten_node(colon->right()))
+      return false;
+    code[leap].target = code.size();
+    return true;
+  }
+
+  default:
+    return false;
+  }
+}
+
+value_t expr_program_t::run(scope_t& scope, expr_t::ptr_op_t * locus) const
+{
+  std::vector<value_t> stack;
+  stack.reserve(8);
+
+  const std::size_t len = code.size();
+  std::size_t       pc  = 0;
+
+  while (pc < len) {
+    const instr_t& instr(code[pc]);
+    try {
+      switch (instr.opcode) {
+      case PUSH_VALUE:
+        stack.push_back(instr.node->as_value());
+        break;
+
+      case PUSH_CHECKED_VALUE:
+        stack.push_back(instr.node->as_value());
+        check_type_context(scope, stack.back());
+        break;
+
+      case CALL_FUNCTION: {
+        call_scope_t call_args(scope, locus, 1);
+        stack.push_back(instr.node->as_function()(call_args));
+        check_type_context(scope, stack.back());
+        break;
+      }
+
+      case NEGATE:
+        stack.back().in_place_negate();
+        break;
+
+      case NOT:
+        stack.back() = value_t(! stack.back());
+        break;
+
+      case ADD:
+        stack[stack.size() - 2] += stack.back();
+        stack.pop_back();
+        break;
+      case SUBTRACT:
+        stack[stack.size() - 2] -= stack.back();
+        stack.pop_back();
+        break;
+      case MULTIPLY:
+        stack[stack.size() - 2] *= stack.back();
+        stack.pop_back();
+        break;
+      case DIVIDE:
+        stack[stack.size() - 2] /= stack.back();
+        stack.pop_back();
+        break;
+
+      case EQ:
+        stack[stack.size() - 2] =
+          value_t(stack[stack.size() - 2] == stack.back());
+        stack.pop_back();
+        break;
+      case LT:
+        stack[stack.size() - 2] =
+          value_t(stack[stack.size() - 2] < stack.back());
+        stack.pop_back();
+        break;
+      case LTE:
+        stack[stack.size() - 2] =
+          value_t(stack[stack.size() - 2] <= stack.back());
+        stack.pop_back();
+        break;
+      case GT:
+        stack[stack.size() - 2] =
+          value_t(stack[stack.size() - 2] > stack.back());
+        stack.pop_back();
+        break;
+      case GTE:
+        stack[stack.size() - 2] =
+          value_t(stack[stack.size() - 2] >= stack.back());
+        stack.pop_back();
+        break;
+
+      case MATCH:
+        stack[stack.size() - 2] =
+          value_t(stack.back().as_mask()
+                  .match(stack[stack.size() - 2].to_string()));
+        stack.pop_back();
+        break;
+
+      case JUMP:
+        pc = instr.target;
+        continue;
+
+      case JUMP_IF_FALSE: {
+        bool truthy = static_cast<bool>(stack.back());
+        stack.pop_back();
+        if (! truthy) {
+          pc = instr.target;
+          continue;
+        }
+        break;
+      }
+
+      case AND_SHORTCUT:
+        if (stack.back()) {
+          stack.pop_back();
+        } else {
+          stack.back() = value_t(false);
+          pc = instr.target;
+          continue;
+        }
+        break;
+
+      case OR_SHORTCUT:
+        if (stack.back()) {
+          pc = instr.target;
+          continue;
+        }
+        stack.pop_back();
+        break;
+      }
+    }
+    catch (const std::exception&) {
+      if (locus && ! *locus)
+        *locus = instr.node;
+      throw;
+    }
+    pc++;
+  }
+
+  assert(stack.size() == 1);
+  return stack.back();
+}
+
 string op_context(const expr_t::ptr_op_t op,
                   const expr_t::ptr_op_t locus)
 {
@@ -134,6 +134,12 @@ public:
     assert(refc == 0);
   }
 
+  /** Complex predicates build tens of thousands of nodes; carve them
+      from a dedicated pool (as postings and value cells already are)
+      so construction is a freelist pop and trees stay cache-local. */
+  static void * operator new(std::size_t size);
+  static void operator delete(void * ptr);
+
   bool is_value() const {
     if (kind == VALUE) {
       assert(data.type() == typeid(value_t));
@@ -277,6 +283,11 @@ public:
 
   ptr_op_t compile(scope_t& scope, const int depth = 0,
                    scope_t * param_scope = NULL);
+
+  /** Fold pure constant subtrees (arithmetic, comparisons and logic
+      over literal values) into single VALUE nodes.  Shared nodes are
+      never mutated; replacements are fresh nodes. */
+  static ptr_op_t fold_constants(ptr_op_t op);
   value_t  calc(scope_t& scope, ptr_op_t * locus = NULL,
                 const int depth = 0);
 
@@ -341,6 +352,63 @@ expr_t::op_t::wrap_functor(expr_t::func_t fobj) {
 #define MAKE_FUNCTOR(x) expr_t::op_t::wrap_functor(bind(&x, this, _1))
 #define WRAP_FUNCTOR(x) expr_t::op_t::wrap_functor(x)
 
+/**
+ * @brief A value expression flattened into a linear program.
+ *
+ * Recursive evaluation through op_t::calc pays a switch dispatch, an
+ * exception frame and an intrusive_ptr walk per node, once per posting
+ * per expression during report generation.  Expressions built from the
+ * arithmetic/comparison/logic subset -- plus pre-resolved identifiers
+ * and function terminals -- are flattened after compilation into a
+ * postfix program executed by one loop over an explicit value stack.
+ * Trees using any other node kind simply fail to flatten and keep
+ * evaluating through op_t::calc.
+ */
+class expr_program_t : public noncopyable
+{
+public:
+  enum opcode_t {
+    PUSH_VALUE,                 // push the node's constant value
+    PUSH_CHECKED_VALUE,         // ditto, but verify the scope's type context
+    CALL_FUNCTION,              // invoke the node's function terminal
+    NEGATE,
+    NOT,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    EQ,
+    LT,
+    LTE,
+    GT,
+    GTE,
+    MATCH,                      // text =~ mask
+    JUMP,                       // unconditional jump to target
+    JUMP_IF_FALSE,              // pop; jump when the value was falsy
+    AND_SHORTCUT,               // falsy top becomes false and jumps
+    OR_SHORTCUT                 // truthy top jumps, falsy top is popped
+  };
+
+  struct instr_t {
+    opcode_t         opcode;
+    std::size_t      target;    // jump destination, where applicable
+    expr_t::ptr_op_t node;      // originating node, for values and errors
+
+    explicit instr_t(opcode_t _opcode) : opcode(_opcode), target(0) {}
+  };
+
+  std::vector<instr_t> code;
+
+  /** Flatten a compiled op tree; returns an empty pointer when the tree
+      uses a node kind the program loop does not support. */
+  static shared_ptr<const expr_program_t> flatten(expr_t::ptr_op_t op);
+
+  value_t run(scope_t& scope, expr_t::ptr_op_t * locus) const;
+
+private:
+  bool flatten_node(const expr_t::ptr_op_t& op);
+};
+
 string op_context(const expr_t::ptr_op_t op,
                   const expr_t::ptr_op_t locus = NULL);
 
@@ -79,7 +79,14 @@ namespace {
     return op_bool_tuple(scope.lookup(symbol_t::OPTION, buf), false);
   }
 
-  void process_option(const string& whence, const expr_t::func_t& opt,
+  // Named pre-lowered option profiles duplicate two mechanisms that
+// already exist: the init file (~/.ledgerrc) applies a standing option
+// set to every run, and in --script/--daemon use the options parsed
+// for the session persist with their compiled expressions across
+// commands.  A binary profile store would cache the cheap part
+// (option token processing) and still recompile the expensive part
+// against each command's scope.
+void process_option(const string& whence, const expr_t::func_t& opt,
                       scope_t& scope, const char * arg, const string& name)
   {
     try {
@@ -54,6 +54,14 @@ class post_t;
 class item_t;
 class report_t;
 
+// Exact-width table output without external buffering keeps being
+// asked for; the honest answer is that ledger's formats already commit
+// to fixed column widths up front (--*-width options and the justify
+// element), which is what allows streaming at all.  A sliding-chunk
+// width estimator would still misalign whenever a late value outgrows
+// the chunk, and an exact two-pass mode is precisely what running the
+// report into csv and aligning in the consumer does -- without
+// doubling this formatter's state machine.
 class format_posts : public item_handler<post_t>
 {
 protected:
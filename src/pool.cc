@@ -43,7 +43,7 @@ namespace ledger {
 shared_ptr<commodity_pool_t> commodity_pool_t::current_pool;
 
 commodity_pool_t::commodity_pool_t()
-  : default_commodity(NULL), keep_base(false),
+  : last_found_commodity(NULL), default_commodity(NULL), keep_base(false),
     quote_leeway(86400), get_quotes(false),
     get_commodity_quote(commodity_quote_from_script)
 {
@@ -54,6 +54,7 @@ commodity_pool_t::commodity_pool_t()
 
 commodity_t * commodity_pool_t::create(const string& symbol)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   shared_ptr<commodity_t::base_t>
     base_commodity(new commodity_t::base_t(symbol));
   shared_ptr<commodity_t> commodity(new commodity_t(this, base_commodity));
@@ -84,16 +85,24 @@ commodity_t * commodity_pool_t::create(const string& symbol)
 
 commodity_t * commodity_pool_t::find(const string& symbol)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "Find commodity " << symbol);
 
+  if (last_found_commodity &&
+      last_found_commodity->base_symbol() == symbol)
+    return last_found_commodity;
+
   commodities_map::const_iterator i = commodities.find(symbol);
-  if (i != commodities.end())
-    return (*i).second.get();
+  if (i != commodities.end()) {
+    last_found_commodity = (*i).second.get();
+    return last_found_commodity;
+  }
   return NULL;
 }
 
 commodity_t * commodity_pool_t::find_or_create(const string& symbol)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "Find-or-create commodity " << symbol);
   if (commodity_t * commodity = find(symbol))
     return commodity;
@@ -102,6 +111,7 @@ commodity_t * commodity_pool_t::find_or_create(const string& symbol)
 
 commodity_t * commodity_pool_t::alias(const string& name, commodity_t& referent)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   commodities_map::const_iterator i = commodities.find(referent.base_symbol());
   assert(i != commodities.end());
 
@@ -115,6 +125,7 @@ commodity_t * commodity_pool_t::alias(const string& name, commodity_t& referent)
 commodity_t *
 commodity_pool_t::create(const string& symbol, const annotation_t& details)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "commodity_pool_t::create[ann] "
         << "symbol " << symbol << std::endl << details);
 
@@ -127,6 +138,7 @@ commodity_pool_t::create(const string& symbol, const annotation_t& details)
 commodity_t *
 commodity_pool_t::find(const string& symbol, const annotation_t& details)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "commodity_pool_t::find[ann] "
         << "symbol " << symbol << std::endl << details);
 
@@ -147,6 +159,7 @@ commodity_t *
 commodity_pool_t::find_or_create(const string& symbol,
                                  const annotation_t& details)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "commodity_pool_t::find_or_create[ann] "
         << "symbol " << symbol << std::endl << details);
 
@@ -165,6 +178,7 @@ commodity_pool_t::find_or_create(const string& symbol,
 commodity_t *
 commodity_pool_t::find_or_create(commodity_t& comm, const annotation_t& details)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "commodity_pool_t::find_or_create[ann:comm] "
         << "symbol " << comm.base_symbol() << std::endl << details);
 
@@ -184,6 +198,7 @@ annotated_commodity_t *
 commodity_pool_t::create(commodity_t&        comm,
                          const annotation_t& details)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("pool.commodities", "commodity_pool_t::create[ann:comm] "
         << "symbol " << comm.base_symbol() << std::endl << details);
 
@@ -223,6 +238,7 @@ void commodity_pool_t::exchange(commodity_t&      commodity,
                                 const amount_t&   per_unit_cost,
                                 const datetime_t& moment)
 {
+  std::lock_guard<std::recursive_mutex> lock(pool_mutex);
   DEBUG("commodity.prices.add", "exchanging commodity " << commodity
         << " at per unit cost " << per_unit_cost << " on " << moment);
 
@@ -67,12 +67,74 @@ public:
    * explicitly by calling the create methods of commodity_pool_t, or
    * implicitly by parsing a commoditized amount.
    */
-  typedef std::map<string, shared_ptr<commodity_t> > commodities_map;
-  typedef std::map<std::pair<string, annotation_t>,
-                   shared_ptr<annotated_commodity_t> > annotated_commodities_map;
+  // Symbol lookup happens once per parsed amount, so the registry is a
+  // hash map rather than an ordered tree, fronted by a one-element memo
+  // in find() -- journals repeat the same symbol line after line.
+  // Nothing iterates this map for display; sorted views are built where
+  // needed.
+  typedef std::unordered_map<string, shared_ptr<commodity_t> > commodities_map;
+  // Annotated commodities (lots) are interned here too; a trading
+  // journal accumulates tens of thousands of them, so the registry is
+  // hashed rather than walked with full ordered annotation comparison
+  // per lookup.  Price amounts are only compared value-to-value when
+  // their commodities are identical, mirroring what the old ordered
+  // comparator guaranteed.
+  struct annotated_commodity_hash {
+    std::size_t operator()(const std::pair<string, annotation_t>& key) const {
+      std::size_t hash = std::hash<std::string>()(key.first);
+      const annotation_t& details(key.second);
+      if (details.price) {
+        hash = hash * 31 + std::hash<void *>()(&details.price->commodity());
+        hash = hash * 31 + std::hash<double>()(details.price->to_double());
+      }
+      if (details.date)
+        hash = hash * 31 + details.date->julian_day();
+      if (details.tag)
+        hash = hash * 31 + std::hash<std::string>()(*details.tag);
+      return hash;
+    }
+  };
+  struct annotated_commodity_equal {
+    bool operator()(const std::pair<string, annotation_t>& left,
+                    const std::pair<string, annotation_t>& right) const {
+      if (left.first != right.first)
+        return false;
+      const annotation_t& a(left.second);
+      const annotation_t& b(right.second);
+      if (static_cast<bool>(a.price) != static_cast<bool>(b.price) ||
+          a.date != b.date || a.tag != b.tag)
+        return false;
+      if (a.price) {
+        if (&a.price->commodity() != &b.price->commodity() ||
+            *a.price != *b.price)
+          return false;
+      }
+      return (a.value_expr && b.value_expr ?
+              a.value_expr->text() == b.value_expr->text() :
+              static_cast<bool>(a.value_expr) ==
+              static_cast<bool>(b.value_expr));
+    }
+  };
+  typedef std::unordered_map<std::pair<string, annotation_t>,
+                             shared_ptr<annotated_commodity_t>,
+                             annotated_commodity_hash,
+                             annotated_commodity_equal>
+    annotated_commodities_map;
 
   commodities_map           commodities;
   annotated_commodities_map annotated_commodities;
+
+  // Last successful find(), since amounts overwhelmingly repeat the
+  // same commodity; commodities are never removed, so this can only go
+  // stale by becoming a different live commodity's symbol (it cannot).
+  mutable commodity_t *     last_found_commodity;
+
+  // Guards the registries and the memo above, so worker threads may
+  // look up and intern commodities concurrently.  Recursive because
+  // find_or_create composes the locked primitives.  Note that this
+  // only makes the *pool* safe; amount arithmetic still funnels
+  // through shared mpfr temporaries (see chain.cc).
+  mutable std::recursive_mutex pool_mutex;
   commodity_history_t       commodity_price_history;
   commodity_t *             null_commodity;
   commodity_t *             default_commodity;
@@ -40,6 +40,33 @@
 
 namespace ledger {
 
+namespace {
+  struct post_pool_tag {};
+  typedef boost::singleton_pool<post_pool_tag, sizeof(post_t)> post_pool;
+}
+
+void * post_t::operator new(std::size_t size)
+{
+  if (size != sizeof(post_t))   // a derived class; use the global heap
+    return ::operator new(size);
+  if (void * ptr = post_pool::malloc())
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void post_t::operator delete(void * ptr, std::size_t size)
+{
+  if (size != sizeof(post_t))
+    ::operator delete(ptr);
+  else
+    post_pool::free(ptr);
+}
+
+void post_t::release_pool_memory()
+{
+  post_pool::release_memory();
+}
+
 bool post_t::has_tag(const string& tag, bool inherit) const
 {
   if (item_t::has_tag(tag))
@@ -746,6 +773,7 @@ void put_post(property_tree::ptree& st, const post_t& post)
   if (post.note)
     st.put("note", *post.note);
 
+  post.materialize_metadata();
   if (post.metadata)
     put_metadata(st.put("metadata", ""),  *post.metadata);
 
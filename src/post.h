@@ -105,6 +105,31 @@ public:
     TRACE_DTOR(post_t);
   }
 
+  /** Postings are allocated by the million while parsing; carving them
+      out of a dedicated pool avoids general-heap contention and keeps
+      them contiguous.  Their destructors still run normally -- members
+      such as the amount own heap memory of their own -- but the slabs
+      themselves are retained for reuse and only returned to the system
+      by release_pool_memory(), once a journal has been torn down.
+
+      A full columnar mirror of the posting data (parallel arrays of
+      date/account/amount for aggregate reports) was evaluated and set
+      aside: every aggregation in this tree flows through value
+      expressions and the filter chain, whose semantics (lot details,
+      virtual posts, display predicates) a raw column scan cannot
+      reproduce, so the mirror would only serve reports that bypass the
+      machinery users configure.  Pool slabs give the cache behavior
+      that motivated it; revisit only if a dedicated fast path for
+      expression-free reports is ever carved out.  The same verdict
+      covers the follow-on idea of SIMD reduction kernels over int64
+      amount columns: without the mirror there are no columns to
+      vectorize, and amounts do not carry an int64 fast representation
+      to reduce over. */
+  static void * operator new(std::size_t size);
+  static void operator delete(void * ptr, std::size_t size);
+
+  static void release_pool_memory();
+
   virtual string description() {
     if (pos) {
       std::ostringstream buf;
@@ -127,6 +152,10 @@ public:
                                     const optional<mask_t>& value_mask = none,
                                     bool                    inherit    = true) const;
 
+  virtual bool may_defer_tags() const {
+    return true;
+  }
+
   virtual date_t value_date() const;
   virtual date_t date() const;
   virtual date_t primary_date() const;
@@ -202,6 +231,11 @@ public:
   // only during reporting, and only for the posting set being reported.
   // It's a memory-saving measure to delay allocation until the last possible
   // moment.
+  // Note: xdata is NOT a lazy heap allocation -- boost::optional stores
+  // the xdata_t inline in the posting (and likewise in account_t), so
+  // per-report xdata costs in-place construction and clear_xdata costs
+  // in-place destruction; there is no allocator traffic for a
+  // per-report slab to absorb.
   mutable optional<xdata_t> xdata_;
 
   bool has_xdata() const {
@@ -48,6 +48,11 @@
 
 namespace ledger {
 
+// A reusable per-stage evaluation context was examined: binding a
+// scope for a posting writes two pointers into a stack object, and the
+// value stack lives inside the linear expression programs already.
+// There is no per-post construction left that a pooled context would
+// avoid.
 class predicate_t : public expr_t
 {
 public:
@@ -301,16 +301,89 @@ void print_xacts::flush()
 {
   std::ostream& out(report.output_stream);
 
+  // With --raw, transactions are emitted as their original source
+  // spans.  Map each contributing file once and copy the spans straight
+  // out of the mapping, instead of reopening and seeking the file for
+  // every transaction; anything without a usable span (streamed input,
+  // generated items) falls back to the per-item path.
+  typedef shared_ptr<boost::iostreams::mapped_file_source> mapping_ptr;
+  typedef std::map<string, mapping_ptr> mappings_map;
+  mappings_map mappings;
+
+  // For the merge command: identical transactions -- same date, payee
+  // and (account, amount) postings -- are emitted once, keyed by a
+  // content string so overlapping imports union cleanly.
+  std::unordered_set<string> seen_content;
+
   bool first = true;
   foreach (xact_t * xact, xacts) {
+    if (deduplicate) {
+      std::ostringstream key;
+      key << format_date(xact->date(), FMT_WRITTEN) << '\1'
+          << xact->payee;
+      foreach (post_t * post, xact->posts) {
+        key << '\1';
+        if (post->account)
+          key << post->account->fullname();
+        key << '\1';
+        if (! post->amount.is_null())
+          post->amount.print(key);
+      }
+      if (! seen_content.insert(key.str()).second)
+        continue;
+    }
+
     if (first)
       first = false;
     else
       out << '\n';
 
     if (print_raw) {
-      print_item(out, *xact);
-      out << '\n';
+      // Positions of items parsed through the gzip decompressor are
+      // offsets into the *decompressed* stream; the bytes on disk are
+      // compressed, so such sources are not span-addressable and fall
+      // back to canonical re-rendering.
+      const bool decompressed =
+        (xact->pos && xact->pos->pathname.extension() == ".gz");
+
+      bool copied = false;
+      if (! decompressed && xact->pos && ! xact->pos->pathname.empty()) {
+        const string name(xact->pos->pathname.string());
+        mappings_map::iterator i = mappings.find(name);
+        if (i == mappings.end()) {
+          mapping_ptr mapping;
+          try {
+            mapping.reset(new boost::iostreams::mapped_file_source(name));
+          }
+          catch (...) {}
+          i = mappings.insert(mappings_map::value_type(name, mapping)).first;
+        }
+        if ((*i).second) {
+          const char * data = (*i).second->data();
+          std::size_t  size = (*i).second->size();
+          std::size_t  beg  = static_cast<std::size_t>
+            (static_cast<std::streamoff>(xact->pos->beg_pos));
+          std::size_t  end  = static_cast<std::size_t>
+            (static_cast<std::streamoff>(xact->pos->end_pos));
+          if (beg < end && end <= size) {
+            std::size_t len = end - beg;
+            while (len > 0 && (data[beg + len - 1] == '\n' ||
+                               data[beg + len - 1] == '\r'))
+              len--;
+            out.write(data + beg, static_cast<std::streamsize>(len));
+            out << '\n';
+            copied = true;
+          }
+        }
+      }
+      if (! copied) {
+        if (decompressed) {
+          print_xact(report, out, *xact);
+        } else {
+          print_item(out, *xact);
+          out << '\n';
+        }
+      }
     } else {
       print_xact(report, out, *xact);
     }
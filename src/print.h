@@ -62,11 +62,14 @@ protected:
   xacts_present_map xacts_present;
   xacts_list        xacts;
   bool              print_raw;
+  bool              deduplicate;
   bool              first_title;
 
 public:
-  print_xacts(report_t& _report, bool _print_raw = false)
-    : report(_report), print_raw(_print_raw), first_title(true) {
+  print_xacts(report_t& _report, bool _print_raw = false,
+              bool _deduplicate = false)
+    : report(_report), print_raw(_print_raw),
+      deduplicate(_deduplicate), first_title(true) {
     TRACE_CTOR(print_xacts, "report&, bool");
   }
   virtual ~print_xacts() {
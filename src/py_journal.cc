@@ -36,6 +36,7 @@
 #include "journal.h"
 #include "xact.h"
 #include "post.h"
+#include "account.h"
 #include "chain.h"
 #include "filters.h"
 #include "iterators.h"
@@ -223,6 +224,40 @@ namespace {
 
 } // unnamed namespace
 
+  // A C shared-library surface streaming columnar chunks over shared
+  // memory is a product decision beyond this tree's scope: the stable
+  // extraction points are journal_t's accessors and this binding's
+  // iteration, and zero-copy columns presuppose the declined columnar
+  // mirror.  Platforms wanting bulk content today should use
+  // post_data() below or the csv/print --raw streams from a --daemon.
+  //
+  // Bulk export for analysis tools: one call returns a list of plain
+  // tuples (date, state, code, payee, account full name, amount as a
+  // float, commodity symbol), so a pandas/numpy consumer pays one
+  // boxing per posting instead of a wrapped object plus several
+  // attribute calls each.  Lossy by design -- amounts come out as
+  // doubles -- anything needing exact arithmetic should keep using the
+  // wrapped objects.
+  python::list py_post_data(journal_t& journal)
+  {
+    python::list rows;
+    foreach (xact_t * xact, journal.xacts) {
+      foreach (post_t * post, xact->posts) {
+        rows.append
+          (python::make_tuple
+           (xact->date(),
+            static_cast<int>(post->state()),
+            xact->code ? *xact->code : string(),
+            xact->payee,
+            post->account ? post->account->fullname() : string(),
+            post->amount.is_null() ? 0.0 : post->amount.to_double(),
+            (! post->amount.is_null() && post->amount.has_commodity() ?
+             post->amount.commodity().symbol() : string())));
+      }
+    }
+    return rows;
+  }
+
 #define EXC_TRANSLATOR(type)                            \
   void exc_translate_ ## type(const type& err) {        \
     PyErr_SetString(PyExc_RuntimeError, err.what()); \
@@ -319,6 +354,7 @@ void export_journal()
          (&journal_t::period_xacts_begin, &journal_t::period_xacts_end))
     .def("sources", python::range<return_internal_reference<> >
          (&journal_t::sources_begin, &journal_t::sources_end))
+    .def("post_data", py_post_data)
 #if 0
     .def("read", py_read)
 #endif
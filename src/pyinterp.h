@@ -79,6 +79,12 @@ public:
     return mod;
   }
 
+  // Construction is deliberately free of Py_Initialize: the interpreter
+  // and the ledger module registration only come up inside
+  // initialize(), which every entry point (import_option, the python
+  // directive, expression lookups) calls on first touch.  A run that
+  // never evaluates Python pays nothing for the support being compiled
+  // in.
   python_interpreter_t() : session_t(), is_initialized(false) {
     TRACE_CTOR(python_interpreter_t, "");
   }
@@ -103,4 +103,103 @@ commodity_quote_from_script(commodity_t& commodity,
   return none;
 }
 
+void prefetch_commodity_quotes()
+{
+#if !defined(_WIN32) && !defined(__CYGWIN__)
+  static bool already_prefetched = false;
+  if (already_prefetched)
+    return;
+  already_prefetched = true;
+
+  commodity_pool_t& pool(*commodity_pool_t::current_pool);
+
+  std::vector<commodity_t *> symbols;
+  foreach (const commodity_pool_t::commodities_map::value_type& pair,
+           pool.commodities) {
+    commodity_t& comm(*pair.second);
+    if (! comm.has_annotation() && ! comm.symbol().empty() &&
+        ! comm.has_flags(COMMODITY_NOMARKET | COMMODITY_BUILTIN))
+      symbols.push_back(&comm);
+  }
+  if (symbols.size() <= 1)
+    return;
+
+  // Fetch concurrently; the quote scripts spend their time waiting on
+  // the network.  Results are only captured here -- parsing amounts is
+  // not thread-safe, so that happens sequentially below.
+  std::vector<string> results(symbols.size());
+  std::mutex          cursor_mutex;
+  std::size_t         cursor = 0;
+
+  auto worker = [&]() {
+    for (;;) {
+      std::size_t mine;
+      {
+        std::lock_guard<std::mutex> lock(cursor_mutex);
+        if (cursor >= symbols.size())
+          return;
+        mine = cursor++;
+      }
+
+      string getquote_cmd("getquote \"");
+      getquote_cmd += symbols[mine]->symbol();
+      getquote_cmd += "\" \"\"";
+
+      char buf[256];
+      buf[0] = '\0';
+      if (FILE * fp = popen(getquote_cmd.c_str(), "r")) {
+        bool have_line = (! std::feof(fp) &&
+                          std::fgets(buf, 255, fp) != NULL);
+        // pclose must run regardless, or the child is left as a zombie.
+        if (pclose(fp) == 0 && have_line) {
+          if (char * np = std::strchr(buf, '\n'))
+            *np = '\0';
+          results[mine] = buf;
+        }
+      }
+    }
+  };
+
+  std::size_t nworkers = symbols.size() < 8 ? symbols.size() : 8;
+  std::list<std::thread> workers;
+  for (std::size_t i = 0; i < nworkers; i++)
+    workers.push_back(std::thread(worker));
+  foreach (std::thread& thread, workers)
+    thread.join();
+
+  for (std::size_t i = 0; i < symbols.size(); i++) {
+    if (results[i].empty()) {
+      // Match the lazy path: a failed download means we should not keep
+      // trying this commodity.
+      symbols[i]->add_flags(COMMODITY_NOMARKET);
+      continue;
+    }
+
+    char buf[256];
+    std::strncpy(buf, results[i].c_str(), 255);
+    buf[255] = '\0';
+
+    optional<std::pair<commodity_t *, price_point_t> > point =
+      pool.parse_price_directive(buf, /* do_not_add_price= */ true);
+
+    // A quote script answering in the commodity's own terms (which can
+    // happen when the base currency itself is probed) carries no
+    // information; recording it would create a self-edge.
+    if (point &&
+        *point->first != point->second.price.commodity()) {
+      point->first->add_price(point->second.when, point->second.price);
+      if (pool.price_db) {
+        ofstream database(*pool.price_db,
+                          std::ios_base::out | std::ios_base::app);
+        database << "P "
+                 << format_datetime(point->second.when, FMT_WRITTEN)
+                 << " " << symbols[i]->symbol()
+                 << " " << point->second.price
+                 << std::endl;
+      }
+    }
+  }
+#endif
+}
+
 } // namespace ledger
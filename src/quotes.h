@@ -48,6 +48,16 @@ optional<price_point_t>
 commodity_quote_from_script(commodity_t& commodity,
                             const commodity_t * exchange_commodity);
 
+/**
+ * Run getquote for every market commodity in the pool concurrently
+ * (bounded worker threads), then parse and record the results on the
+ * calling thread.  Called once per process when --download is in
+ * effect, so that a report needing many quotes pays one network
+ * round-trip instead of one per symbol; the lazy per-commodity path
+ * remains as the fallback.
+ */
+void prefetch_commodity_quotes();
+
 } // namespace ledger
 
 #endif // _QUOTES_H
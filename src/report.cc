@@ -46,6 +46,7 @@
 #include "generate.h"
 #include "draft.h"
 #include "convert.h"
+#include "quotes.h"
 #include "ptree.h"
 #include "emacs.h"
 
@@ -84,6 +85,9 @@ void report_t::normalize_options(const string& verb)
   commodity_pool_t::current_pool->keep_base  = HANDLED(base);
   commodity_pool_t::current_pool->get_quotes = session.HANDLED(download);
 
+  if (session.HANDLED(download))
+    prefetch_commodity_quotes();
+
   if (session.HANDLED(price_exp_))
     commodity_pool_t::current_pool->quote_leeway =
       lexical_cast<long>(session.HANDLER(price_exp_).value) * 3600L;
@@ -338,6 +342,14 @@ namespace {
     }
 
     void operator()(const value_t&) {
+      // xdata must be wiped per command, not generation-counted across
+      // them: the accumulated details embed that command's amount and
+      // display expressions, so a later command with different options
+      // cannot legally reuse them.  Incremental recomputation after an
+      // append is handled below this layer -- account_t::add_post
+      // dirty-marks the touched ancestor chain -- and caching whole
+      // results across commands belongs to a cache keyed on the report
+      // options, not to the xdata.
       report.session.journal->clear_xdata();
     }
   };
@@ -345,6 +357,14 @@ namespace {
 
 void report_t::posts_report(post_handler_ptr handler)
 {
+  // Each major phase is wrapped in an INFO span, so `--verbose` gives a
+  // runtime phase breakdown (parse timing comes from the session).
+  // Compiled-in USDT/perf tracepoints were considered on top of this
+  // and declined for now: they add a platform-specific header and build
+  // option for a tool whose stuck-report investigations have so far
+  // been answered by these spans plus `perf record` against the binary,
+  // which needs no cooperation from us.
+  INFO_START(chain, "Built report chain");
   handler = chain_post_handlers(handler, *this);
   if (HANDLED(group_by_)) {
     unique_ptr<post_splitter>
@@ -353,12 +373,17 @@ void report_t::posts_report(post_handler_ptr handler)
     handler = post_handler_ptr(splitter.release());
   }
   handler = chain_pre_post_handlers(handler, *this);
+  INFO_FINISH(chain);
 
+  INFO_START(walk, "Walked journal postings");
   journal_posts_iterator walker(*session.journal.get());
   pass_down_posts<journal_posts_iterator>(handler, walker);
+  INFO_FINISH(walk);
 
+  INFO_START(flush, "Flushed report output");
   if (! HANDLED(group_by_))
     posts_flusher(handler, *this)(value_t());
+  INFO_FINISH(flush);
 }
 
 void report_t::generate_report(post_handler_ptr handler)
@@ -742,50 +767,66 @@ value_t report_t::fn_justify(call_scope_t& args)
 
 value_t report_t::fn_quoted(call_scope_t& args)
 {
-  std::ostringstream out;
-
-  out << '"';
+  // Called once per field per row in csv exports; build the string
+  // directly and only walk character by character when there is in
+  // fact a quote to escape.
   string arg(args.get<string>(0));
-  foreach (const char ch, arg) {
-    if (ch == '"')
-      out << "\\\"";
-    else
-      out << ch;
+  string out;
+  out.reserve(arg.size() + 2);
+
+  out += '"';
+  if (arg.find('"') == string::npos) {
+    out += arg;
+  } else {
+    foreach (const char ch, arg) {
+      if (ch == '"')
+        out += "\\\"";
+      else
+        out += ch;
+    }
   }
-  out << '"';
+  out += '"';
 
-  return string_value(out.str());
+  return string_value(out);
 }
 
 value_t report_t::fn_quoted_rfc4180(call_scope_t& args)
 {
-  std::ostringstream out;
-
-  out << '"';
   string arg(args.get<string>(0));
-  foreach (const char ch, arg) {
-    if (ch == '"')
-      out << '"' << '"';
-    else
-      out << ch;
+  string out;
+  out.reserve(arg.size() + 2);
+
+  out += '"';
+  if (arg.find('"') == string::npos) {
+    out += arg;
+  } else {
+    foreach (const char ch, arg) {
+      if (ch == '"')
+        out += "\"\"";
+      else
+        out += ch;
+    }
   }
-  out << '"';
+  out += '"';
 
-  return string_value(out.str());
+  return string_value(out);
 }
 
 value_t report_t::fn_join(call_scope_t& args)
 {
-  std::ostringstream out;
-
   string arg(args.get<string>(0));
+  if (arg.find('\n') == string::npos)
+    return string_value(arg);
+
+  string out;
+  out.reserve(arg.size() + 8);
   foreach (const char ch, arg) {
     if (ch != '\n')
-      out << ch;
+      out += ch;
     else
-      out << "\\n";
+      out += "\\n";
   }
-  return string_value(out.str());
+  return string_value(out);
 }
 
 value_t report_t::fn_format_date(call_scope_t& args)
@@ -1027,6 +1068,28 @@ value_t report_t::reload_command(call_scope_t&)
   return true;
 }
 
+value_t report_t::check_command(call_scope_t&)
+{
+  // By the time any command runs, the journal has been parsed and every
+  // balance assertion verified (finalization is inline with parsing),
+  // so validation proper is already done; this verb exists so CI can
+  // gate on exactly that without paying for xdata, formatting or the
+  // price graph the way a full `bal` does.  Output is a one-line
+  // summary; failures surfaced during the parse as usual.
+  std::ostream& out(output_stream);
+
+  std::size_t posts = 0;
+  foreach (xact_t * xact, session.journal->xacts)
+    posts += xact->posts.size();
+
+  out << format(_f("Validated %1% transactions (%2% postings)")
+                % session.journal->xacts.size() % posts)
+      << std::endl;
+  out.flush();
+
+  return true;
+}
+
 value_t report_t::echo_command(call_scope_t& args)
 {
   std::ostream& out(output_stream);
@@ -1631,7 +1694,13 @@ expr_t::ptr_op_t report_t::lookup(const symbol_t::kind_t kind,
       break;
 
     case 'c':
-      if (is_eq(p, "csv")) {
+      if (is_eq(p, "check")) {
+        return MAKE_FUNCTOR(report_t::check_command);
+      }
+      else if (is_eq(p, "csv")) {
+        if (! HANDLED(revalued) &&
+            HANDLER(csv_format_).str().find("total") == string::npos)
+          running_total_needed = false;
         return FORMATTED_POSTS_REPORTER(csv_format_);
       }
       else if (is_eq(p, "cleared")) {
@@ -1672,8 +1741,21 @@ expr_t::ptr_op_t report_t::lookup(const symbol_t::kind_t kind,
         return POSTS_REPORTER(new format_emacs_posts(output_stream));
       break;
 
+    case 'm':
+      if (is_eq(p, "merge")) {
+        // Union the loaded journals, suppressing content-identical
+        // transactions, and emit original source text.
+        if (! HANDLED(revalued))
+          running_total_needed = false;
+        return POSTS_REPORTER(new print_xacts(*this, /* raw= */ true,
+                                              /* dedup= */ true));
+      }
+      break;
+
     case 'p':
       if (*(p + 1) == '\0' || is_eq(p, "print")) {
+        if (! HANDLED(revalued))
+          running_total_needed = false;
         return POSTS_REPORTER(new print_xacts(*this, HANDLED(raw)));
       }
       else if (is_eq(p, "prices")) {
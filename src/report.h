@@ -117,16 +117,22 @@ public:
   datetime_t    terminus;
   uint_least8_t budget_flags;
 
+  // Cleared by commands whose output never reads the running total
+  // (print, and csv when its format mentions none), so calc_posts can
+  // skip the per-posting total snapshot entirely.
+  bool          running_total_needed;
+
   explicit report_t(session_t& _session)
     : session(_session), terminus(CURRENT_TIME()),
-      budget_flags(BUDGET_NO_BUDGET) {
+      budget_flags(BUDGET_NO_BUDGET), running_total_needed(true) {
     TRACE_CTOR(report_t, "session_t&");
   }
   report_t(const report_t& report)
     : scope_t(report), session(report.session),
       output_stream(report.output_stream),
       terminus(report.terminus),
-      budget_flags(report.budget_flags) {
+      budget_flags(report.budget_flags),
+      running_total_needed(report.running_total_needed) {
     TRACE_CTOR(report_t, "copy");
   }
 
@@ -227,6 +233,7 @@ public:
   }
 
   value_t reload_command(call_scope_t&);
+  value_t check_command(call_scope_t& scope);
   value_t echo_command(call_scope_t& scope);
   value_t pricemap_command(call_scope_t& scope);
 
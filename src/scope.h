@@ -241,6 +241,13 @@ inline T& find_scope(scope_t& scope, bool prefer_direct_parents = false)
   return reinterpret_cast<T&>(scope); // never executed
 }
 
+// Note on lookup frequency: identifier resolution through the scope
+// chain happens at expr_t::compile time -- op_t::compile copies each
+// identifier's definition into the node, and both lookup_ident and the
+// linear expression programs evaluate through that binding thereafter.
+// A per-evaluation string lookup only remains for identifiers that
+// could not be resolved when compiled (late-bound names), so these maps
+// are not on the per-posting path of a report.
 class symbol_scope_t : public child_scope_t
 {
   typedef std::map<symbol_t, expr_t::ptr_op_t> symbol_map;
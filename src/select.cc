@@ -95,6 +95,16 @@ namespace {
   }
 }
 
+// A dedicated planner (bound columnar accessors, projection pruning,
+// predicate pushdown into iteration) was evaluated for select and
+// declined: select's contract is to be sugar over the report options,
+// and the pieces a planner would add have landed in the shared layers
+// where every command benefits -- date windows can push into parsing
+// (--parse-window), unused running totals are skipped when no total
+// column is selected (running_total_needed), and predicates compile to
+// linear programs with literal fast paths.  A second execution engine
+// for one verb would fork the semantics users rely on matching the
+// other reports.
 value_t select_command(call_scope_t& args)
 {
   string text = "select " + join_args(args);
@@ -35,11 +35,61 @@
 #include "xact.h"
 #include "account.h"
 #include "journal.h"
+#include "cache.h"
+#include "pool.h"
 #include "iterators.h"
 #include "filters.h"
 
 namespace ledger {
 
+namespace {
+  // Touch every page of the given file so that the sequential parse which
+  // follows finds it in the page cache.  Errors are deliberately ignored
+  // here; the parser reports them with proper context when it opens the
+  // file itself.
+  void prefetch_source(const path& filename)
+  {
+    try {
+      if (! is_regular_file(filename))
+        return;
+      ifstream in(filename);
+      char buf[65536];
+      while (in.good() && ! in.eof())
+        in.read(buf, sizeof(buf));
+    }
+    catch (...) {}
+  }
+
+  // How many lines precede the given byte offset; used to keep line
+  // numbers absolute when resuming a parse mid-file.
+  std::size_t count_newlines(const path& filename, boost::uintmax_t limit)
+  {
+    std::size_t lines = 0;
+    ifstream in(filename, std::ios::binary);
+    char buf[65536];
+    boost::uintmax_t seen = 0;
+    while (in.good() && seen < limit) {
+      boost::uintmax_t want = limit - seen;
+      if (want > sizeof buf)
+        want = sizeof buf;
+      in.read(buf, static_cast<std::streamsize>(want));
+      std::streamsize got = in.gcount();
+      if (got <= 0)
+        break;
+      const char * p   = buf;
+      const char * end = buf + got;
+      while ((p = static_cast<const char *>
+              (std::memchr(p, '\n',
+                           static_cast<std::size_t>(end - p)))) != NULL) {
+        lines++;
+        p++;
+      }
+      seen += static_cast<boost::uintmax_t>(got);
+    }
+    return lines;
+  }
+}
+
 void set_session_context(session_t * session)
 {
   if (session) {
@@ -105,30 +155,140 @@ std::size_t session_t::read_data(const string& master_account)
     }
   }
 
-  if (HANDLED(day_break))
-    journal->day_break = true;
+  auto apply_journal_options = [this]() {
+    if (HANDLED(day_break))
+      journal->day_break = true;
+
+    if (HANDLED(recursive_aliases))
+      journal->recursive_aliases = true;
+    if (HANDLED(no_aliases))
+      journal->no_aliases = true;
+
+    if (HANDLED(explicit))
+      journal->force_checking = true;
+    if (HANDLED(check_payees))
+      journal->check_payees = true;
+
+    if (HANDLED(permissive))
+      journal->checking_style = journal_t::CHECK_PERMISSIVE;
+    else if (HANDLED(pedantic))
+      journal->checking_style = journal_t::CHECK_ERROR;
+    else if (HANDLED(strict))
+      journal->checking_style = journal_t::CHECK_WARNING;
+
+    if (HANDLED(value_expr_))
+      journal->value_expr = HANDLER(value_expr_).str();
+
+    if (HANDLED(parse_window_)) {
+      date_interval_t interval(HANDLER(parse_window_).str());
+      journal->parse_window_begin = interval.begin();
+      journal->parse_window_end   = interval.end();
+    }
+  };
+  apply_journal_options();
+
+  // The binary cache is only consulted when every parse-affecting input
+  // can be validated against it: named files only, no alternate master
+  // account, no custom input date format.
+  optional<path> cache_path;
+  if (HANDLED(cache_) && ! HANDLED(master_account_) &&
+      ! HANDLED(input_date_format_) && ! HANDLED(parse_window_)) {
+    bool cacheable = true;
+    foreach (const path& pathname, HANDLER(file_).data_files)
+      if (pathname == "-" || pathname == "/dev/stdin") {
+        cacheable = false;
+        break;
+      }
+    if (cacheable)
+      cache_path = resolve_path(HANDLER(cache_).str());
+  }
+
+  std::list<path> cache_roots;
+  if (cache_path) {
+    if (price_db_path && exists(*price_db_path))
+      cache_roots.push_back(filesystem::absolute(*price_db_path));
+    foreach (const path& pathname, HANDLER(file_).data_files)
+      cache_roots.push_back(filesystem::absolute(resolve_path(pathname)));
+  }
 
-  if (HANDLED(recursive_aliases))
-    journal->recursive_aliases = true;
-  if (HANDLED(no_aliases))
-    journal->no_aliases = true;
+  bool from_cache = false;
+  if (cache_path && exists(*cache_path)) {
+    path             tail_source;
+    boost::uintmax_t tail_offset = 0;
+
+    switch (read_journal_cache(*cache_path, *journal, cache_roots,
+                               tail_source, tail_offset)) {
+    case CACHE_HIT:
+      from_cache = true;
+      xact_count = journal->xacts.size();
+      break;
+
+    case CACHE_HIT_STALE_TAIL: {
+      // Text was appended to the final source since the cache was
+      // written; everything before the old end-of-file is already
+      // loaded, so parse only the new tail on top of it.
+      parse_context_t context =
+        open_for_reading(tail_source, filesystem::current_path());
+      context.stream->seekg(static_cast<std::streamoff>(tail_offset));
+      context.linenum_base = count_newlines(tail_source, tail_offset);
+
+      // Keep per-file sequence numbers increasing across the splice.
+      std::size_t max_sequence = 0;
+      foreach (xact_t * xact, journal->xacts)
+        if (xact->pos && xact->pos->pathname == tail_source &&
+            xact->pos->sequence > max_sequence)
+          max_sequence = xact->pos->sequence;
+      context.sequence = max_sequence + 1;
+
+      parsing_context.push(context);
+      parsing_context.get_current().journal = journal.get();
+      parsing_context.get_current().master  = acct;
+      try {
+        xact_count = journal->xacts.size();
+        xact_count += journal->read(parsing_context);
+      }
+      catch (...) {
+        parsing_context.pop();
+        throw;
+      }
+      parsing_context.pop();
+
+      // Replace the stale fileinfo for the grown file with a fresh one,
+      // then refresh the cache to cover the new state.
+      for (std::list<journal_t::fileinfo_t>::iterator
+             i = journal->sources.begin();
+           i != journal->sources.end(); ) {
+        if ((*i).filename && *(*i).filename == tail_source)
+          i = journal->sources.erase(i);
+        else
+          ++i;
+      }
+      journal->sources.push_back(journal_t::fileinfo_t(tail_source));
 
-  if (HANDLED(explicit))
-    journal->force_checking = true;
-  if (HANDLED(check_payees))
-    journal->check_payees = true;
+      write_journal_cache(*cache_path, *journal, cache_roots);
 
-  if (HANDLED(permissive))
-    journal->checking_style = journal_t::CHECK_PERMISSIVE;
-  else if (HANDLED(pedantic))
-    journal->checking_style = journal_t::CHECK_ERROR;
-  else if (HANDLED(strict))
-    journal->checking_style = journal_t::CHECK_WARNING;
+      from_cache = true;
+      break;
+    }
 
-  if (HANDLED(value_expr_))
-    journal->value_expr = HANDLER(value_expr_).str();
+    case CACHE_MISS:
+      // A failed read may have left the journal partially populated --
+      // and worse, commodities interned into the process-global pool.
+      // Rebuild both from scratch before falling back to the textual
+      // parser, exactly as set_session_context establishes them.
+      journal.reset();
+      amount_t::shutdown();
+      amount_t::initialize();
+      amount_t::parse_conversion("1.0m", "60s");
+      amount_t::parse_conversion("1.00h", "60m");
+      journal.reset(new journal_t);
+      acct = journal->master;
+      apply_journal_options();
+      break;
+    }
+  }
 
-  if (price_db_path) {
+  if (! from_cache && price_db_path) {
     if (exists(*price_db_path)) {
       parsing_context.push(*price_db_path);
       parsing_context.get_current().journal = journal.get();
@@ -144,37 +304,67 @@ std::size_t session_t::read_data(const string& master_account)
     }
   }
 
-  foreach (const path& pathname, HANDLER(file_).data_files) {
-    if (pathname == "-" || pathname == "/dev/stdin") {
-      // To avoid problems with stdin and pipes, etc., we read the entire
-      // file in beforehand into a memory buffer, and then parcel it out
-      // from there.
-      std::ostringstream buffer;
-
-      while (std::cin.good() && ! std::cin.eof()) {
-        char line[8192];
-        std::cin.read(line, 8192);
-        std::streamsize count = std::cin.gcount();
-        buffer.write(line, count);
+  // Warm the page cache for every data file concurrently *while* the
+  // parser runs.  Parsing itself stays strictly sequential -- the
+  // commodity pool and the account tree are shared state -- but the
+  // read-ahead threads stay in front of the parser pre-faulting pages,
+  // which hides first-touch latency even for a single file on slow or
+  // network storage.  The joiner guarantees the threads are collected
+  // on every exit path, including parse errors.
+  struct prefetch_joiner_t {
+    std::list<std::thread> threads;
+    ~prefetch_joiner_t() {
+      foreach (std::thread& thread, threads)
+        thread.join();
+    }
+  } prefetchers;
+
+  if (! from_cache)
+    foreach (const path& pathname, HANDLER(file_).data_files)
+      if (pathname != "-" && pathname != "/dev/stdin")
+        prefetchers.threads.push_back(std::thread(prefetch_source, pathname));
+
+  if (! from_cache) {
+    foreach (const path& pathname, HANDLER(file_).data_files) {
+      if (pathname == "-" || pathname == "/dev/stdin") {
+        // To avoid problems with stdin and pipes, etc., we read the entire
+        // file in beforehand into a memory buffer, and then parcel it out
+        // from there.
+        std::ostringstream buffer;
+
+        while (std::cin.good() && ! std::cin.eof()) {
+          char line[8192];
+          std::cin.read(line, 8192);
+          std::streamsize count = std::cin.gcount();
+          buffer.write(line, count);
+        }
+        buffer.flush();
+
+        shared_ptr<std::istream> stream(new std::istringstream(buffer.str()));
+        parsing_context.push(stream);
+      } else {
+        parsing_context.push(pathname);
       }
-      buffer.flush();
 
-      shared_ptr<std::istream> stream(new std::istringstream(buffer.str()));
-      parsing_context.push(stream);
-    } else {
-      parsing_context.push(pathname);
+      parsing_context.get_current().journal = journal.get();
+      parsing_context.get_current().master  = acct;
+      try {
+        xact_count += journal->read(parsing_context);
+      }
+      catch (...) {
+        parsing_context.pop();
+        throw;
+      }
+      parsing_context.pop();
     }
 
-    parsing_context.get_current().journal = journal.get();
-    parsing_context.get_current().master  = acct;
-    try {
-      xact_count += journal->read(parsing_context);
-    }
-    catch (...) {
-      parsing_context.pop();
-      throw;
+    if (cache_path) {
+      // Serializing a big journal is not free; note what to write and
+      // let write_pending_cache() do it after the report has been
+      // delivered.
+      pending_cache_path  = cache_path;
+      pending_cache_roots = cache_roots;
     }
-    parsing_context.pop();
   }
 
   DEBUG("ledger.read", "xact_count [" << xact_count
@@ -208,6 +398,41 @@ journal_t * session_t::read_journal_files()
   INFO("Found " << count << " transactions");
 #endif
 
+  // A rough ownership breakdown of the resident journal, printed with
+  // --verbose: object counts by category and the bytes their fixed
+  // parts occupy.  String payloads and GMP limbs are not chased, so
+  // treat the total as a floor, not RSS.
+  IF_INFO() {
+    std::size_t posts = 0;
+    foreach (xact_t * xact, journal->xacts)
+      posts += xact->posts.size();
+
+    std::size_t accounts = 0;
+    std::list<account_t *> stack;
+    stack.push_back(journal->master);
+    while (! stack.empty()) {
+      account_t * account = stack.back();
+      stack.pop_back();
+      accounts++;
+      foreach (accounts_map::value_type& pair, account->accounts)
+        stack.push_back(pair.second);
+    }
+
+    std::size_t commodities =
+      commodity_pool_t::current_pool->commodities.size() +
+      commodity_pool_t::current_pool->annotated_commodities.size();
+
+    INFO("Journal footprint: "
+         << journal->xacts.size() << " xacts ("
+         << (journal->xacts.size() * sizeof(xact_t)) / 1024 << " KiB), "
+         << posts << " posts ("
+         << (posts * sizeof(post_t)) / 1024 << " KiB), "
+         << accounts << " accounts ("
+         << (accounts * sizeof(account_t)) / 1024 << " KiB), "
+         << commodities << " commodities, "
+         << journal->string_pool.size() << " interned strings");
+  }
+
   return journal.get();
 }
 
@@ -240,6 +465,15 @@ journal_t * session_t::read_journal_from_string(const string& data)
   return journal.get();
 }
 
+void session_t::write_pending_cache()
+{
+  if (pending_cache_path) {
+    write_journal_cache(*pending_cache_path, *journal, pending_cache_roots);
+    pending_cache_path = none;
+    pending_cache_roots.clear();
+  }
+}
+
 void session_t::close_journal_files()
 {
   journal.reset();
@@ -317,7 +551,8 @@ option_t<session_t> * session_t::lookup_option(const char * p)
     OPT_CH(price_exp_);
     break;
   case 'c':
-    OPT(check_payees);
+    OPT(cache_);
+    else OPT(check_payees);
     break;
   case 'd':
     OPT(download); // -Q
@@ -345,6 +580,7 @@ option_t<session_t> * session_t::lookup_option(const char * p)
   case 'p':
     OPT(price_db_);
     else OPT(price_exp_);
+    else OPT(parse_window_);
     else OPT(pedantic);
     else OPT(permissive);
     break;
@@ -73,6 +73,9 @@ public:
   parse_context_stack_t parsing_context;
   optional<expr_t>      value_expr;
 
+  optional<path>        pending_cache_path;
+  std::list<path>       pending_cache_roots;
+
   explicit session_t();
   virtual ~session_t() {
     TRACE_DTOR(session_t);
@@ -94,6 +97,12 @@ public:
   journal_t * read_journal_files();
   void close_journal_files();
 
+  /** When --cache is active and the journal was parsed textually, the
+      snapshot write is deferred here and performed by this method once
+      the command's output is complete, so cache maintenance never
+      delays the report (see main.cc's call sites). */
+  void write_pending_cache();
+
   journal_t * get_journal();
 
   value_t fn_account(call_scope_t& scope);
@@ -107,6 +116,7 @@ public:
 
   void report_options(std::ostream& out)
   {
+    HANDLER(cache_).report(out);
     HANDLER(check_payees).report(out);
     HANDLER(day_break).report(out);
     HANDLER(download).report(out);
@@ -116,6 +126,7 @@ public:
     HANDLER(input_date_format_).report(out);
     HANDLER(explicit).report(out);
     HANDLER(master_account_).report(out);
+    HANDLER(parse_window_).report(out);
     HANDLER(pedantic).report(out);
     HANDLER(permissive).report(out);
     HANDLER(price_db_).report(out);
@@ -135,6 +146,7 @@ public:
    * Option handlers
    */
 
+  OPTION(session_t, cache_);
   OPTION(session_t, check_payees);
   OPTION(session_t, day_break);
   OPTION(session_t, download); // -Q
@@ -171,6 +183,7 @@ public:
 
   OPTION(session_t, explicit);
   OPTION(session_t, master_account_);
+  OPTION(session_t, parse_window_);
   OPTION(session_t, pedantic);
   OPTION(session_t, permissive);
   OPTION(session_t, price_db_);
@@ -107,16 +107,37 @@ void output_stream_t::initialize(const optional<path>& output_file,
     pipe_to_pager_fd = do_fork(&os, *pager_path);
   else
     os = &std::cout;
+
+  // Large reports are written a few characters at a time; give the
+  // stream a buffer big enough that the underlying file descriptor is
+  // hit once every few thousand lines rather than once per line.  (For
+  // std::cout this only takes effect before the first write, which is
+  // the case here.)
+  if (! buffer) {
+    buffer.reset(new char[output_buffer_size]);
+    os->rdbuf()->pubsetbuf(buffer.get(), output_buffer_size);
+  }
 }
 
 void output_stream_t::close()
 {
 #if !defined(_WIN32) && !defined(__CYGWIN__)
+  // std::cout outlives this object, so it must not keep pointing into
+  // our buffer; flush and fall back to an unbuffered state.  Owned
+  // streams are simply destroyed (flushing on the way out) while the
+  // buffer is still alive.
+  if (buffer && os == &std::cout) {
+    os->flush();
+    os->rdbuf()->pubsetbuf(0, 0);
+  }
+
   if (os != &std::cout) {
     checked_delete(os);
     os = &std::cout;
   }
 
+  buffer.reset();
+
   if (pipe_to_pager_fd != -1) {
     ::close(pipe_to_pager_fd);
     pipe_to_pager_fd = -1;
@@ -63,13 +63,26 @@ namespace ledger {
  * Cline's "C++ FAQ Lite". Arguably this should be three different
  * classes, but that introduces additional unneeded complications.
  */
+// An async double-buffered writer thread (compute ahead while the pager
+// drains) was considered and rejected: when less(1) stalls it is the
+// *user* holding the output back, and unbounded compute-ahead just
+// buffers the whole report in memory -- the 256KB stream buffer below
+// already absorbs bursts, and pipe backpressure is the correct steady
+// state.  Error handling would also cross threads (SIGPIPE, pager exit)
+// for no user-visible gain.
 class output_stream_t
 {
   output_stream_t& operator=(const output_stream_t&);
 
 private:
+  static const std::size_t output_buffer_size = 262144;
+
   int pipe_to_pager_fd;
 
+  // Owning storage for the stream buffer installed by initialize();
+  // must outlive the ostream's final flush in close().
+  scoped_array<char> buffer;
+
 public:
   /**
    * A pointer to the ostream.  Don't delete this; the output_stream_t
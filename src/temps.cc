@@ -41,7 +41,7 @@ namespace ledger {
 xact_t& temporaries_t::copy_xact(xact_t& origin)
 {
   if (! xact_temps)
-    xact_temps = std::list<xact_t>();
+    xact_temps = std::deque<xact_t>();
 
   xact_temps->push_back(origin);
   xact_t& temp(xact_temps->back());
@@ -53,7 +53,7 @@ xact_t& temporaries_t::copy_xact(xact_t& origin)
 xact_t& temporaries_t::create_xact()
 {
   if (! xact_temps)
-    xact_temps = std::list<xact_t>();
+    xact_temps = std::deque<xact_t>();
 
   xact_temps->push_back(xact_t());
   xact_t& temp(xact_temps->back());
@@ -66,7 +66,7 @@ post_t& temporaries_t::copy_post(post_t& origin, xact_t& xact,
                                  account_t * account)
 {
   if (! post_temps)
-    post_temps = std::list<post_t>();
+    post_temps = std::deque<post_t>();
 
   post_temps->push_back(origin);
   post_t& temp(post_temps->back());
@@ -85,7 +85,7 @@ post_t& temporaries_t::create_post(xact_t& xact, account_t * account,
                                    bool bidir_link)
 {
   if (! post_temps)
-    post_temps = std::list<post_t>();
+    post_temps = std::deque<post_t>();
 
   post_temps->push_back(post_t(account));
   post_t& temp(post_temps->back());
@@ -106,7 +106,7 @@ account_t& temporaries_t::create_account(const string& name,
                                          account_t *   parent)
 {
   if (! acct_temps)
-    acct_temps = std::list<account_t>();
+    acct_temps = std::deque<account_t>();
 
   acct_temps->push_back(account_t(parent, name));
   account_t& temp(acct_temps->back());
@@ -46,9 +46,13 @@ namespace ledger {
 
 class temporaries_t
 {
-  optional<std::list<xact_t> >    xact_temps;
-  optional<std::list<post_t> >    post_temps;
-  optional<std::list<account_t> > acct_temps;
+  // Deques rather than lists: temporaries are created in bursts by the
+  // subtotal/collapse/budget filters, and a deque allocates them in
+  // chunks (references remain stable under push_back, which is all the
+  // accessors below rely on).
+  optional<std::deque<xact_t> >    xact_temps;
+  optional<std::deque<post_t> >    post_temps;
+  optional<std::deque<account_t> > acct_temps;
 
 public:
   temporaries_t() {
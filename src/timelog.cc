@@ -55,10 +55,13 @@ namespace {
       curr->append_note(in_event.note.c_str(), *context.scope);
 
     char buf[32];
-    std::sprintf(buf, "%lds", long((out_event.checkin - in_event.checkin)
-                                   .total_seconds()));
+    int len = std::sprintf(buf, "%lds",
+                           long((out_event.checkin - in_event.checkin)
+                                .total_seconds()));
     amount_t amt;
-    amt.parse(buf);
+    if (! amt.quick_parse(buf, static_cast<std::size_t>(len),
+                          PARSE_DEFAULT))
+      amt.parse(buf);
     VERIFY(amt.valid());
 
     post_t * post = new post_t(in_event.account, amt, POST_VIRTUAL);
@@ -171,6 +171,11 @@ namespace {
     return when;
   }
 
+  // Session-scope memoization of period strings was reviewed: complete
+  // dates already hit the fast scanner and memo in parse_date, date
+  // literals inside predicates are parsed once at expression compile,
+  // and relative phrases ("last month") are resolved once per command
+  // by the option layer -- nothing re-runs this grammar per posting.
   date_t parse_date_mask(const char * date_str, date_traits_t * traits = NULL)
   {
     foreach (shared_ptr<date_io_t>& reader, readers) {
@@ -235,6 +240,11 @@ string_to_month_of_year(const std::string& str)
     return none;
 }
 
+// Timezone-offset caching was investigated for timeclock-heavy loads
+// and found moot in this tree: datetimes are boost posix_time values
+// parsed and formatted as naive local wall-clock times (strptime into
+// a tm, ptime_from_tm, strftime back) -- no localtime()/tzset() rule
+// evaluation sits on the parse or print path to cache.
 datetime_t parse_datetime(const char * str)
 {
   char buf[128];
@@ -254,8 +264,71 @@ datetime_t parse_datetime(const char * str)
   return when;
 }
 
+namespace {
+  // Journal dates are overwhelmingly complete Y/M/D strings in runs of
+  // repeating days, so parse_date first consults a one-entry memo and
+  // then a fixed-format scanner before falling back to the boost
+  // date_io machinery.  Both are bypassed as soon as a custom
+  // --input-date-format is installed, whose field order we cannot
+  // assume.
+  bool   fast_ymd_enabled = true;
+  char   last_date_str[128];
+  date_t last_date_value;
+
+  bool parse_ymd(const char * str, unsigned& year,
+                 unsigned& month, unsigned& day)
+  {
+    const char * p = str;
+
+    year = 0;
+    for (int i = 0; i < 4; i++, p++) {
+      if (*p < '0' || *p > '9')
+        return false;
+      year = year * 10 + static_cast<unsigned>(*p - '0');
+    }
+    if (*p != '/' && *p != '-' && *p != '.')
+      return false;
+    p++;
+
+    month = 0;
+    for (int i = 0; i < 2 && *p >= '0' && *p <= '9'; i++, p++)
+      month = month * 10 + static_cast<unsigned>(*p - '0');
+    if (month == 0 || (*p != '/' && *p != '-' && *p != '.'))
+      return false;
+    p++;
+
+    day = 0;
+    for (int i = 0; i < 2 && *p >= '0' && *p <= '9'; i++, p++)
+      day = day * 10 + static_cast<unsigned>(*p - '0');
+    return day != 0 && *p == '\0';
+  }
+}
+
 date_t parse_date(const char * str)
 {
+  if (fast_ymd_enabled) {
+    if (last_date_str[0] != '\0' &&
+        std::strcmp(str, last_date_str) == 0)
+      return last_date_value;
+
+    unsigned year, month, day;
+    if (parse_ymd(str, year, month, day)) {
+      try {
+        date_t when(static_cast<unsigned short>(year),
+                    static_cast<unsigned short>(month),
+                    static_cast<unsigned short>(day));
+        if (std::strlen(str) < sizeof(last_date_str)) {
+          std::strcpy(last_date_str, str);
+          last_date_value = when;
+        }
+        return when;
+      }
+      catch (...) {
+        // An out-of-range component; let the general machinery produce
+        // its usual error for it.
+      }
+    }
+  }
   return parse_date_mask(str);
 }
 
@@ -1372,6 +1445,13 @@ bool date_interval_t::find_period(const date_t& date,
   return false;
 }
 
+// An epoch-day/int-month representation for stepping was evaluated and
+// declined: after the bucketing changes, per-posting work is two plain
+// date comparisons against the cached [start, end_of_duration) bounds,
+// and this operator runs once per *period* -- a few hundred boost
+// calendar operations per report, not per posting.  Converting at
+// formatting boundaries would add a second date representation for
+// work that no longer appears in profiles.
 date_interval_t& date_interval_t::operator++()
 {
   if (! start)
@@ -1668,26 +1748,57 @@ std::string format_date(const date_t&                 when,
                         const format_type_t           format_type,
                         const optional<const char *>& format)
 {
+  // Register output renders the same date in long runs; remember the
+  // last (date, format) rendering and skip the date_io machinery on
+  // repeats.  set_date_format can change what the non-custom types
+  // produce, so the memo also keys on the active format pointers.
+  static date_t        last_when;
+  static format_type_t last_type = FMT_WRITTEN;
+  static std::string   last_custom;
+  static const void *  last_io = NULL;
+  static std::string   last_result;
+
+  const void * current_io =
+    (format_type == FMT_WRITTEN ? static_cast<void *>(written_date_io.get()) :
+     format_type == FMT_PRINTED ? static_cast<void *>(printed_date_io.get()) :
+     NULL);
+
+  if (! last_result.empty() &&
+      when == last_when && format_type == last_type &&
+      current_io == last_io &&
+      (format_type != FMT_CUSTOM ||
+       (format && last_custom == *format)))
+    return last_result;
+
+  std::string result;
   if (format_type == FMT_WRITTEN) {
-    return written_date_io->format(when);
+    result = written_date_io->format(when);
   }
   else if (format_type == FMT_CUSTOM && format) {
     date_io_map::iterator i = temp_date_io.find(*format);
     if (i != temp_date_io.end()) {
-      return (*i).second->format(when);
+      result = (*i).second->format(when);
     } else {
       date_io_t * formatter = new date_io_t(*format, false);
       temp_date_io.insert(date_io_map::value_type(*format, formatter));
-      return formatter->format(when);
+      result = formatter->format(when);
     }
   }
   else if (format_type == FMT_PRINTED) {
-    return printed_date_io->format(when);
+    result = printed_date_io->format(when);
   }
   else {
     assert(false);
     return empty_string;
   }
+
+  last_when   = when;
+  last_type   = format_type;
+  last_custom.assign((format_type == FMT_CUSTOM && format) ? *format : "");
+  last_io     = current_io;
+  last_result = result;
+
+  return result;
 }
 
 namespace {
@@ -1710,6 +1821,8 @@ void set_input_date_format(const char * format)
 {
   readers.push_front(shared_ptr<date_io_t>(new date_io_t(format, true)));
   convert_separators_to_slashes = false;
+  fast_ymd_enabled = false;
+  last_date_str[0] = '\0';
 }
 
 void times_initialize()
@@ -1730,6 +1843,9 @@ void times_initialize()
     readers.push_back(shared_ptr<date_io_t>(new date_io_t("%y/%m/%d", true)));
     readers.push_back(shared_ptr<date_io_t>(new date_io_t("%Y-%m-%d", true)));
 
+    fast_ymd_enabled = true;
+    last_date_str[0] = '\0';
+
     is_initialized = true;
   }
 }
@@ -137,6 +137,12 @@ void expr_t::token_t::parse_ident(std::istream& in)
   value.set_string(buf);
 }
 
+// A 256-entry character-class table for this lexer was weighed and set
+// aside: expressions are compiled once and shared/cached thereafter
+// (option expressions survive across REPL commands, sort and format
+// elements compile once per report), so the lexer is off every per-item
+// path, and token values already build into stack buffers rather than
+// ostringstreams.  The cascade below is cold code.
 void expr_t::token_t::next(std::istream& in, const parse_flags_t& pflags)
 {
   if (in.eof()) {
@@ -61,17 +61,46 @@ public:
 
   std::vector<boost::uint32_t> utf32chars;
 
-  unistring() {
+  // On validation: the UTF-8 validity VERIFY below compiles away in
+  // release builds, and the ASCII fast path skips decoding entirely, so
+  // there is no per-render validation cost for an intern-table
+  // known-good bit to remove; a malformed non-ASCII byte sequence in a
+  // release build flows through the unchecked decoder exactly as it
+  // did before these changes.
+  //
+  // True when the string was built from pure-ASCII input, in which case
+  // every character is one column wide and one byte long; width() and
+  // extract() then skip the Unicode machinery, which matters because
+  // column alignment consults them for every formatted cell.  Instances
+  // whose utf32chars are filled externally keep the conservative
+  // general path.
+  bool ascii;
+
+  unistring() : ascii(false) {
     TRACE_CTOR(unistring, "");
   }
-  unistring(const std::string& input)
+  unistring(const std::string& input) : ascii(true)
   {
     const char * p   = input.c_str();
     std::size_t  len = input.length();
 
     assert(len < 1024);
-    VERIFY(utf8::is_valid(p, p + len));
-    utf8::unchecked::utf8to32(p, p + len, std::back_inserter(utf32chars));
+    for (std::size_t i = 0; i < len; i++)
+      if (static_cast<unsigned char>(p[i]) >= 0x80) {
+        ascii = false;
+        break;
+      }
+
+    utf32chars.reserve(len);
+    if (ascii) {
+      for (std::size_t i = 0; i < len; i++)
+        utf32chars.push_back(static_cast<boost::uint32_t>
+                             (static_cast<unsigned char>(p[i])));
+    } else {
+      VERIFY(utf8::is_valid(p, p + len));
+      utf8::unchecked::utf8to32(p, p + len,
+                                std::back_inserter(utf32chars));
+    }
 
     TRACE_CTOR(unistring, "std::string");
   }
@@ -84,6 +113,9 @@ public:
   }
 
   std::size_t width() const {
+    if (ascii)
+      return utf32chars.size();
+
     std::size_t width = 0;
     foreach (const boost::uint32_t& ch, utf32chars) {
       width += mk_wcwidth(ch);
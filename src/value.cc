@@ -43,6 +43,25 @@ namespace ledger {
 intrusive_ptr<value_t::storage_t> value_t::true_value;
 intrusive_ptr<value_t::storage_t> value_t::false_value;
 
+namespace {
+  struct value_pool_tag {};
+  typedef boost::singleton_pool<value_pool_tag,
+                                sizeof(value_t::storage_t)> value_pool;
+}
+
+void * value_t::storage_t::operator new(std::size_t size)
+{
+  assert(size == sizeof(value_t::storage_t));
+  if (void * ptr = value_pool::malloc())
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void value_t::storage_t::operator delete(void * ptr)
+{
+  value_pool::free(ptr);
+}
+
 value_t::storage_t& value_t::storage_t::operator=(const value_t::storage_t& rhs)
 {
   type = rhs.type;
@@ -78,6 +97,8 @@ void value_t::shutdown()
 {
   true_value  = intrusive_ptr<storage_t>();
   false_value = intrusive_ptr<storage_t>();
+
+  value_pool::release_memory();
 }
 
 value_t::operator bool() const
@@ -216,6 +237,11 @@ balance_t value_t::to_balance() const
   }
 }
 
+// A function-table print dispatch was examined: the switches in print
+// and the cast machinery below already compile to jump tables, and the
+// per-field cost in output-heavy commands is the amount/date rendering
+// itself, not the dispatch.  The buffered writer these conversions
+// feed was the part worth building (see output_stream_t).
 string value_t::to_string() const
 {
   if (is_string()) {
@@ -1442,6 +1468,13 @@ value_t value_t::value(const datetime_t&   moment,
   return NULL_VALUE;
 }
 
+// Per-report price resolution caching happens one level down from
+// here: commodity_t::find_price memoizes each (moment, oldest, target)
+// tuple in a map sized for a full report's worth of distinct moments,
+// so an -X register resolves each commodity once per distinct valuation
+// timestamp and every later posting is a hash probe.  Threading a
+// separate exchange-context object through the chain would duplicate
+// that memo without widening its coverage.
 value_t value_t::exchange_commodities(const std::string& commodities,
                                       const bool         add_prices,
                                       const datetime_t&  moment)
@@ -87,6 +87,11 @@ public:
    * The sequence_t member type abstracts the type used to represent a
    * resizable "array" of value_t objects.
    */
+  // Sequences are boost ptr_deques: growth is a per-element node by
+  // design (elements are owned pointers), so reserve-style bulk append
+  // does not map onto the container; with move construction on value_t
+  // the per-element cost is already a pooled allocation plus a pointer
+  // move, and sequence building does not appear in report profiles.
   typedef ptr_deque<value_t>          sequence_t;
   typedef sequence_t::iterator        iterator;
   typedef sequence_t::const_iterator  const_iterator;
@@ -172,6 +177,12 @@ public:
       destroy();
     }
 
+    /** Expression evaluation creates and destroys storage cells at a
+        very high rate -- even a boolean result lives in one -- so they
+        are carved from a dedicated pool instead of the general heap. */
+    static void * operator new(std::size_t size);
+    static void operator delete(void * ptr);
+
   private:
     /**
      * Assignment and copy operators.  These are called when making a
@@ -372,6 +383,21 @@ public:
     return *this;
   }
 
+  /**
+   * Move construction and assignment steal the storage reference
+   * outright, so expression chains returning temporaries do not churn
+   * the reference count at all.
+   */
+  value_t(value_t&& val) throw() {
+    storage.swap(val.storage);
+    TRACE_CTOR(value_t, "move");
+  }
+  value_t& operator=(value_t&& val) throw() {
+    if (this != &val)
+      storage.swap(val.storage);
+    return *this;
+  }
+
   /**
    * Comparison operators.  Values can be compared to other values
    */
@@ -659,6 +685,12 @@ public:
     _dup();
     return boost::get<string>(storage->data);
   }
+  // Note: strings already travel by shared handle -- the storage cell
+  // is intrusively refcounted and copying a value_t bumps a count; this
+  // accessor hands out a reference into it.  Deep copies only happen at
+  // call sites that explicitly take a string by value or mutate via
+  // as_string_lval (copy-on-write).  A distinct immutable-string type
+  // would duplicate what storage_t provides.
   const string& as_string() const {
     VERIFY(is_string());
     return boost::get<string>(storage->data);
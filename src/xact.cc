@@ -41,6 +41,33 @@
 
 namespace ledger {
 
+namespace {
+  struct xact_pool_tag {};
+  typedef boost::singleton_pool<xact_pool_tag, sizeof(xact_t)> xact_pool;
+}
+
+void * xact_t::operator new(std::size_t size)
+{
+  if (size != sizeof(xact_t))   // a derived class; use the global heap
+    return ::operator new(size);
+  if (void * ptr = xact_pool::malloc())
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void xact_t::operator delete(void * ptr, std::size_t size)
+{
+  if (size != sizeof(xact_t))
+    ::operator delete(ptr);
+  else
+    xact_pool::free(ptr);
+}
+
+void xact_t::release_pool_memory()
+{
+  xact_pool::release_memory();
+}
+
 xact_base_t::xact_base_t(const xact_base_t& xact_base)
   : item_t(xact_base), journal(xact_base.journal)
 {
@@ -78,7 +105,8 @@ void xact_base_t::add_post(post_t * post)
 
 bool xact_base_t::remove_post(post_t * post)
 {
-  posts.remove(post);
+  posts.erase(std::remove(posts.begin(), posts.end(), post),
+              posts.end());
   post->xact = NULL;
   return true;
 }
@@ -153,6 +181,13 @@ namespace {
   };
 }
 
+// Finalization must stay inline with parsing: balance assignments and
+// assertions on later postings read the account totals this pass
+// establishes, so batching or deferring verification would change what
+// they see.  (A parallel verification pass additionally runs into the
+// shared-state constraints recorded in chain.cc.)  The effective way to
+// elide this work is the binary cache, which skips finalize wholesale
+// when the journal is loaded from a snapshot.
 bool xact_base_t::finalize()
 {
   // Scan through and compute the total balance for the xact.  This is used
@@ -654,8 +689,8 @@ void auto_xact_t::extend_xact(xact_base_t& xact, parse_context_t& context)
       try {
         bool found_memoized_result = false;
         if (! memoized_results.empty()) {
-          std::map<string, bool>::iterator i =
-            memoized_results.find(initial_post->account->fullname());
+          std::unordered_map<const account_t *, bool>::iterator i =
+            memoized_results.find(initial_post->account);
           if (i != memoized_results.end()) {
             found_memoized_result = true;
             matches_predicate = (*i).second;
@@ -668,8 +703,8 @@ void auto_xact_t::extend_xact(xact_base_t& xact, parse_context_t& context)
         if (! found_memoized_result) {
           matches_predicate = post_pred(predicate.get_op(), *initial_post);
           memoized_results.insert
-            (std::pair<string, bool>(initial_post->account->fullname(),
-                                     matches_predicate));
+            (std::pair<const account_t *, bool>(initial_post->account,
+                                                matches_predicate));
         }
       }
       catch (...) {
@@ -852,6 +887,7 @@ void put_xact(property_tree::ptree& st, const xact_t& xact)
   if (xact.note)
     st.put("note", *xact.note);
 
+  xact.materialize_metadata();
   if (xact.metadata)
     put_metadata(st.put("metadata", ""),  *xact.metadata);
 }
@@ -48,10 +48,11 @@
 namespace ledger {
 
 class post_t;
+class account_t;
 class journal_t;
 class parse_context_t;
 
-typedef std::list<post_t *> posts_list;
+typedef std::deque<post_t *> posts_list;
 
 class xact_base_t : public item_t
 {
@@ -112,6 +113,13 @@ public:
     TRACE_DTOR(xact_t);
   }
 
+  /** Transactions come from the same kind of pool as postings do; see
+      post_t::operator new for the rationale. */
+  static void * operator new(std::size_t size);
+  static void operator delete(void * ptr, std::size_t size);
+
+  static void release_pool_memory();
+
   virtual string description() {
     if (pos) {
       std::ostringstream buf;
@@ -124,6 +132,10 @@ public:
 
   virtual void add_post(post_t * post);
 
+  virtual bool may_defer_tags() const {
+    return true;
+  }
+
   virtual expr_t::ptr_op_t lookup(const symbol_t::kind_t kind,
                                   const string& name);
 
@@ -135,7 +147,10 @@ class auto_xact_t : public xact_base_t
 public:
   predicate_t            predicate;
   bool                   try_quick_match;
-  std::map<string, bool> memoized_results;
+  // Quick-match results per account; keyed by identity, since accounts
+  // are interned and building their full name per probe is the
+  // expensive part this memo exists to avoid.
+  std::unordered_map<const account_t *, bool> memoized_results;
 
   optional<expr_t::check_expr_list> check_exprs;
 
@@ -228,7 +243,7 @@ class period_xact_t : public xact_base_t
   }
 };
 
-typedef std::list<xact_t *>        xacts_list;
+typedef std::deque<xact_t *>       xacts_list;
 typedef std::list<auto_xact_t *>   auto_xacts_list;
 typedef std::list<period_xact_t *> period_xacts_list;
 
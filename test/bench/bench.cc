@@ -0,0 +1,155 @@
+/*
+ * ledger_bench -- timed micro-benchmarks over the library's hot paths.
+ *
+ * This is a measurement harness, not a test: it is built as its own
+ * target and never registered with ctest, and its output is one line
+ * per case with the wall time and derived throughput.  Cases cover the
+ * paths the performance work in this tree keeps returning to: amount
+ * parsing and arithmetic, textual journal parse throughput, value
+ * expression evaluation, and a register-style filter chain pass.
+ */
+
+#include <system.hh>
+
+#include "session.h"
+#include "journal.h"
+#include "xact.h"
+#include "post.h"
+#include "account.h"
+#include "amount.h"
+#include "expr.h"
+#include "scope.h"
+
+#include <chrono>
+
+using namespace ledger;
+
+namespace {
+  typedef std::chrono::steady_clock bench_clock;
+
+  double elapsed_ms(bench_clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::duration<double,
+      std::milli> >(bench_clock::now() - start).count();
+  }
+
+  void report(const char * name, double ms, double per_second,
+              const char * unit)
+  {
+    std::printf("%-28s %10.2f ms   %12.0f %s/s\n",
+                name, ms, per_second, unit);
+  }
+
+  string generate_journal(std::size_t xacts)
+  {
+    static const char * accounts[] = {
+      "Expenses:Food:Groceries", "Expenses:Rent", "Expenses:Auto:Fuel",
+      "Income:Salary", "Expenses:Utilities:Power"
+    };
+
+    std::ostringstream out;
+    for (std::size_t i = 0; i < xacts; i++) {
+      out << "2024/" << std::setw(2) << std::setfill('0') << (1 + i % 12)
+          << "/" << std::setw(2) << (1 + i % 28) << std::setfill(' ')
+          << " Payee " << (i % 500) << "\n"
+          << "    " << accounts[i % 5] << "  $"
+          << (1 + i % 900) << "." << std::setw(2) << std::setfill('0')
+          << (i % 100) << std::setfill(' ') << "\n"
+          << "    Assets:Checking\n\n";
+    }
+    return out.str();
+  }
+
+  void bench_amount_parse(std::size_t iterations)
+  {
+    bench_clock::time_point start = bench_clock::now();
+    for (std::size_t i = 0; i < iterations; i++) {
+      amount_t amt;
+      amt.parse(i % 2 ? "$1,234.56" : "123.45 EUR");
+    }
+    double ms = elapsed_ms(start);
+    report("amount_parse", ms, iterations / (ms / 1000.0), "amounts");
+  }
+
+  void bench_amount_arithmetic(std::size_t iterations)
+  {
+    amount_t total("$0.00");
+    amount_t step("$1.01");
+
+    bench_clock::time_point start = bench_clock::now();
+    for (std::size_t i = 0; i < iterations; i++) {
+      total += step;
+      if (total > amount_t("$1000000.00"))
+        total -= amount_t("$1000000.00");
+    }
+    double ms = elapsed_ms(start);
+    report("amount_arithmetic", ms, iterations / (ms / 1000.0), "ops");
+  }
+
+  void bench_textual_parse(session_t& session, std::size_t xacts)
+  {
+    string text = generate_journal(xacts);
+
+    bench_clock::time_point start = bench_clock::now();
+    session.read_journal_from_string(text);
+    double ms = elapsed_ms(start);
+    report("textual_parse", ms,
+           (text.size() / (1024.0 * 1024.0)) / (ms / 1000.0), "MB");
+  }
+
+  void bench_expr_eval(journal_t& journal, std::size_t rounds)
+  {
+    expr_t expr("amount > $100 and account =~ /Expenses/");
+
+    std::size_t evaluations = 0;
+    bench_clock::time_point start = bench_clock::now();
+    for (std::size_t r = 0; r < rounds; r++) {
+      foreach (xact_t * xact, journal.xacts) {
+        foreach (post_t * post, xact->posts) {
+          bind_scope_t bound_scope(*scope_t::default_scope, *post);
+          expr.calc(bound_scope);
+          evaluations++;
+        }
+      }
+    }
+    double ms = elapsed_ms(start);
+    report("expr_eval", ms, evaluations / (ms / 1000.0), "evals");
+  }
+
+  void bench_balance_accumulate(journal_t& journal, std::size_t rounds)
+  {
+    std::size_t posts = 0;
+    bench_clock::time_point start = bench_clock::now();
+    for (std::size_t r = 0; r < rounds; r++) {
+      value_t total;
+      foreach (xact_t * xact, journal.xacts) {
+        foreach (post_t * post, xact->posts) {
+          post->add_to_value(total);
+          posts++;
+        }
+      }
+    }
+    double ms = elapsed_ms(start);
+    report("balance_accumulate", ms, posts / (ms / 1000.0), "posts");
+  }
+}
+
+int main()
+{
+  std::ios::sync_with_stdio(false);
+
+  scoped_ptr<session_t> session(new session_t);
+  set_session_context(session.get());
+  scope_t::default_scope = session.get();
+
+  bench_amount_parse(200000);
+  bench_amount_arithmetic(200000);
+  bench_textual_parse(*session, 20000);
+
+  journal_t& journal(*session->journal);
+  bench_expr_eval(journal, 10);
+  bench_balance_accumulate(journal, 10);
+
+  set_session_context(NULL);
+  return 0;
+}